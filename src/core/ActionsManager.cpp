@@ -21,6 +21,7 @@
 
 #include "ActionsManager.h"
 #include "ThemesManager.h"
+#include "Tracer.h"
 #include "../ui/MainWindow.h"
 
 #include <QtCore/QCoreApplication>
@@ -523,6 +524,8 @@ ActionsManager::ActionsManager(QObject *parent) : QObject(parent),
 
 void ActionsManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new ActionsManager(parent);
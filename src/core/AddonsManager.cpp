@@ -22,6 +22,7 @@
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "ThemesManager.h"
+#include "Tracer.h"
 #include "UserScript.h"
 #include "WebBackend.h"
 #ifdef MEERKAT_ENABLE_QTWEBENGINE
@@ -92,6 +93,8 @@ AddonsManager::AddonsManager(QObject *parent) : QObject(parent)
 
 void AddonsManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new AddonsManager(parent);
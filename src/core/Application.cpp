@@ -23,6 +23,7 @@
 #include "AddonsManager.h"
 #include "BookmarksManager.h"
 #include "Console.h"
+#include "FaviconsManager.h"
 #include "GesturesManager.h"
 #include "HandlersManager.h"
 #include "HistoryManager.h"
@@ -32,11 +33,14 @@
 #include "NotificationsManager.h"
 #include "PasswordsManager.h"
 #include "PlatformIntegration.h"
+#include "PreconnectManager.h"
 #include "SearchEnginesManager.h"
 #include "SettingsManager.h"
 #include "SpellCheckManager.h"
 #include "ToolBarsManager.h"
 #include "ThemesManager.h"
+#include "ThumbnailsManager.h"
+#include "Tracer.h"
 #include "TransfersManager.h"
 #include "Utils.h"
 #include "Updater.h"
@@ -56,6 +60,7 @@
 
 #include <QtCore/QBuffer>
 #include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -66,6 +71,7 @@
 #if QT_VERSION >= 0x050400
 #include <QtCore/QStorageInfo>
 #endif
+#include <QtCore/QTimerEvent>
 #include <QtCore/QTranslator>
 #include <QtGui/QDesktopServices>
 #include <QtNetwork/QLocalSocket>
@@ -74,6 +80,9 @@
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QStyle>
 
+#define CONNECTION_MESSAGE_LIMIT 1048576
+#define CONNECTION_TIMEOUT 1000
+
 namespace Meerkat
 {
 
@@ -90,7 +99,8 @@ QList<MainWindow*> Application::m_windows;
 bool Application::m_isHidden(false);
 bool Application::m_isUpdating(false);
 
-Application::Application(int &argc, char **argv) : QApplication(argc, argv)
+Application::Application(int &argc, char **argv) : QApplication(argc, argv),
+	m_deferredInitializationTimer(0)
 {
 	setApplicationName(QLatin1String("Meerkat"));
 	setApplicationDisplayName(QLatin1String("Meerkat Browser"));
@@ -122,6 +132,9 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv)
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("portable"), QCoreApplication::translate("main", "Sets profile and cache paths to directories inside the same directory as that of application binary")));
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("readonly"), QCoreApplication::translate("main", "Tells application to avoid writing data to disk")));
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("report"), QCoreApplication::translate("main", "Prints out diagnostic report and exits application")));
+#ifdef MEERKAT_ENABLE_TRACING
+	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("trace"), QCoreApplication::translate("main", "Writes trace of startup and hot paths to <path> on exit, in Chrome trace event format"), QLatin1String("path"), QString()));
+#endif
 
 	QStringList arguments(this->arguments());
 	const QString argumentsPath(QDir::current().filePath(QLatin1String("arguments.txt")));
@@ -159,6 +172,15 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv)
 
 	m_commandLineParser.process(arguments);
 
+#ifdef MEERKAT_ENABLE_TRACING
+	if (m_commandLineParser.isSet(QLatin1String("trace")))
+	{
+		Tracer::start(QFileInfo(m_commandLineParser.value(QLatin1String("trace"))).absoluteFilePath());
+	}
+#endif
+
+	MEERKAT_TRACE_SCOPE("startup", "Application::Application");
+
 	const bool isPortable(m_commandLineParser.isSet(QLatin1String("portable")));
 	const bool isPrivate(m_commandLineParser.isSet(QLatin1String("privatesession")));
 	bool isReadOnly(m_commandLineParser.isSet(QLatin1String("readonly")));
@@ -224,6 +246,11 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv)
 			{
 				reportOptions |= SettingsReport;
 			}
+
+			if (rawReportOptions.contains("statistics"))
+			{
+				reportOptions |= StatisticsReport;
+			}
 		}
 
 #ifdef Q_OS_WIN
@@ -256,23 +283,20 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv)
 
 	if (socket.waitForConnected(500))
 	{
-		const QStringList decodedArguments(arguments);
-		QStringList encodedArguments;
-
 #ifdef Q_OS_WIN
 		AllowSetForegroundWindow(ASFW_ANY);
 #endif
 
-		for (int i = 0; i < decodedArguments.count(); ++i)
-		{
-			encodedArguments.append(decodedArguments.at(i).toUtf8().toBase64());
-		}
-
-		QTextStream stream(&socket);
-		stream << encodedArguments.join(QLatin1Char(' ')).toUtf8().toBase64();
-		stream.flush();
+		QByteArray message;
+		QDataStream stream(&message, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream << quint32(0) << arguments;
+		stream.device()->seek(0);
+		stream << quint32(message.size() - int(sizeof(quint32)));
 
-		socket.waitForBytesWritten();
+		socket.write(message);
+		socket.waitForBytesWritten(CONNECTION_TIMEOUT);
+		socket.waitForReadyRead(CONNECTION_TIMEOUT);
 
 		return;
 	}
@@ -372,28 +396,24 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv)
 
 	BookmarksManager::createInstance(this);
 
-	GesturesManager::createInstance(this);
-
-	HandlersManager::createInstance(this);
+	FaviconsManager::createInstance(this);
 
 	HistoryManager::createInstance(this);
 
 	NetworkManagerFactory::createInstance(this);
 
-	NotesManager::createInstance(this);
-
-	NotificationsManager::createInstance(this);
-
-	PasswordsManager::createInstance(this);
-
 	SearchEnginesManager::createInstance(this);
 
-	SpellCheckManager::createInstance(this);
+	ThumbnailsManager::createInstance(this);
 
 	ToolBarsManager::createInstance(this);
 
 	TransfersManager::createInstance(this);
 
+//Not needed before first paint; created one per idle pass, or earlier by their accessors on first use, so the order carries no dependencies
+	m_deferredInitializers = {&NotificationsManager::createInstance, &PasswordsManager::createInstance, &HandlersManager::createInstance, &NotesManager::createInstance, &GesturesManager::createInstance, &SpellCheckManager::createInstance, &PreconnectManager::createInstance};
+	m_deferredInitializationTimer = startTimer(0);
+
 	setLocale(SettingsManager::getValue(SettingsManager::Browser_LocaleOption).toString());
 	setQuitOnLastWindowClosed(true);
 
@@ -467,6 +487,10 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv)
 
 Application::~Application()
 {
+#ifdef MEERKAT_ENABLE_TRACING
+	Tracer::save();
+#endif
+
 	m_systemWidgetStyle.clear();
 
 	for (int i = 0; i < m_windows.count(); ++i)
@@ -475,6 +499,23 @@ Application::~Application()
 	}
 }
 
+void Application::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_deferredInitializationTimer)
+	{
+		if (m_deferredInitializers.isEmpty())
+		{
+			killTimer(m_deferredInitializationTimer);
+
+			m_deferredInitializationTimer = 0;
+		}
+		else
+		{
+			m_deferredInitializers.takeFirst()(this);
+		}
+	}
+}
+
 void Application::optionChanged(int identifier, const QVariant &value)
 {
 	if (identifier == SettingsManager::Browser_EnableTrayIconOption)
@@ -545,29 +586,69 @@ void Application::showNotification(Notification *notification)
 
 void Application::newConnection()
 {
-	QLocalSocket *socket(m_localServer->nextPendingConnection());
+	while (m_localServer->hasPendingConnections())
+	{
+		QLocalSocket *socket(m_localServer->nextPendingConnection());
 
-	if (!socket)
+		if (!socket)
+		{
+			return;
+		}
+
+		connect(socket, SIGNAL(readyRead()), this, SLOT(handleConnectionReadyRead()));
+		connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+	}
+}
+
+void Application::handleConnectionReadyRead()
+{
+	QLocalSocket *socket(qobject_cast<QLocalSocket*>(sender()));
+
+	if (!socket || socket->bytesAvailable() < qint64(sizeof(quint32)))
 	{
 		return;
 	}
 
-	socket->waitForReadyRead(1000);
+	quint32 size(0);
+	QDataStream headerStream(socket->peek(sizeof(quint32)));
+	headerStream.setVersion(QDataStream::Qt_5_6);
+	headerStream >> size;
 
-	MainWindow *window(getWindows().isEmpty() ? nullptr : getWindow());
-	QString data;
-	QTextStream stream(socket);
-	stream >> data;
+	if (size > CONNECTION_MESSAGE_LIMIT)
+	{
+		socket->abort();
+
+		return;
+	}
+
+	if (socket->bytesAvailable() < qint64(sizeof(quint32) + size))
+	{
+		return;
+	}
+
+	socket->read(sizeof(quint32));
+
+	QStringList arguments;
+	QDataStream stream(socket->read(size));
+	stream.setVersion(QDataStream::Qt_5_6);
+	stream >> arguments;
 
-	const QStringList encodedArguments(QString(QByteArray::fromBase64(data.toUtf8())).split(QLatin1Char(' ')));
-	QStringList decodedArguments;
+	disconnect(socket, SIGNAL(readyRead()), this, SLOT(handleConnectionReadyRead()));
 
-	for (int i = 0; i < encodedArguments.count(); ++i)
+	socket->write(QByteArray(1, '\x06'));
+	socket->disconnectFromServer();
+
+	if (stream.status() == QDataStream::Ok)
 	{
-		decodedArguments.append(QString(QByteArray::fromBase64(encodedArguments.at(i).toUtf8())));
+		handleArguments(arguments);
 	}
+}
+
+void Application::handleArguments(const QStringList &arguments)
+{
+	MainWindow *window(getWindows().isEmpty() ? nullptr : getWindow());
 
-	m_commandLineParser.parse(decodedArguments);
+	m_commandLineParser.parse(arguments);
 
 	const QString session(m_commandLineParser.value(QLatin1String("session")));
 	const bool isPrivate(m_commandLineParser.isSet(QLatin1String("privatesession")));
@@ -609,8 +690,6 @@ void Application::newConnection()
 		}
 	}
 
-	delete socket;
-
 	if (window)
 	{
 		window->raise();
@@ -948,6 +1027,16 @@ QString Application::createReport(ReportOptions options)
 		stream << ActionsManager::getReport();
 	}
 
+	if (options.testFlag(StatisticsReport))
+	{
+		stream << PreconnectManager::getReport();
+
+		if (webBackend)
+		{
+			stream << webBackend->getReport();
+		}
+	}
+
 	return report.remove(QRegularExpression(QLatin1String(" +$"), QRegularExpression::MultilineOption));
 }
 
@@ -59,7 +59,8 @@ public:
 		KeyboardShortcutsReport = 2,
 		PathsReport = 4,
 		SettingsReport = 8,
-		FullReport = (EnvironmentReport | KeyboardShortcutsReport | PathsReport | SettingsReport)
+		StatisticsReport = 16,
+		FullReport = (EnvironmentReport | KeyboardShortcutsReport | PathsReport | SettingsReport | StatisticsReport)
 	};
 
 	Q_DECLARE_FLAGS(ReportOptions, ReportOption)
@@ -91,16 +92,24 @@ public slots:
 	void close();
 	void setHidden(bool hidden);
 
+protected:
+	void timerEvent(QTimerEvent *event);
+	void handleArguments(const QStringList &arguments);
+
 protected slots:
 	void optionChanged(int identifier, const QVariant &value);
 	void openUrl(const QUrl &url);
 	void updateCheckFinished(const QList<UpdateInformation> &availableUpdates);
 	void newConnection();
+	void handleConnectionReadyRead();
 	void clearHistory();
 	void periodicUpdateCheck();
 	void showUpdateDetails();
 
 private:
+	QList<void (*)(QObject*)> m_deferredInitializers;
+	int m_deferredInitializationTimer;
+
 	static Application *m_instance;
 	static PlatformIntegration *m_platformIntegration;
 	static TrayIcon *m_trayIcon;
@@ -20,6 +20,7 @@
 
 #include "BookmarksManager.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
 #include "Utils.h"
 
 #include <QtCore/QDateTime>
@@ -53,6 +54,8 @@ void BookmarksManager::timerEvent(QTimerEvent *event)
 
 void BookmarksManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new BookmarksManager(parent);
@@ -22,6 +22,7 @@
 #include "HistoryManager.h"
 #include "SessionsManager.h"
 #include "ThemesManager.h"
+#include "Tracer.h"
 #include "Utils.h"
 
 #include <QtCore/QCoreApplication>
@@ -33,13 +34,14 @@
 namespace Meerkat
 {
 
-BookmarksItem::BookmarksItem() : QStandardItem()
+BookmarksItem::BookmarksItem() : QStandardItem(),
+	m_pendingModel(nullptr)
 {
 }
 
 void BookmarksItem::remove()
 {
-	BookmarksModel *model(qobject_cast<BookmarksModel*>(this->model()));
+	BookmarksModel *model(this->model() ? qobject_cast<BookmarksModel*>(this->model()) : m_pendingModel);
 
 	if (model)
 	{
@@ -59,6 +61,11 @@ void BookmarksItem::setData(const QVariant &value, int role)
 	}
 	else
 	{
+		if (m_pendingModel && role == BookmarksModel::KeywordRole)
+		{
+			m_pendingModel->updatePendingKeyword(data(role).toString(), value.toString());
+		}
+
 		QStandardItem::setData(value, role);
 	}
 }
@@ -198,8 +205,12 @@ QList<QUrl> BookmarksItem::getUrls() const
 BookmarksModel::BookmarksModel(const QString &path, FormatMode mode, QObject *parent) : QStandardItemModel(parent),
 	m_rootItem(new BookmarksItem()),
 	m_trashItem(new BookmarksItem()),
-	m_mode(mode)
+	m_mode(mode),
+	m_changesDepth(0),
+	m_hasPendingChanges(false)
 {
+	MEERKAT_TRACE_FUNCTION("bookmarks");
+
 	m_rootItem->setData(RootBookmark, TypeRole);
 	m_rootItem->setData(((mode == NotesMode) ? tr("Notes") : tr("Bookmarks")), TitleRole);
 	m_rootItem->setDragEnabled(false);
@@ -249,12 +260,57 @@ BookmarksModel::BookmarksModel(const QString &path, FormatMode mode, QObject *pa
 		}
 	}
 
-	connect(this, SIGNAL(itemChanged(QStandardItem*)), this, SIGNAL(modelModified()));
-	connect(this, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SIGNAL(modelModified()));
+	connect(this, SIGNAL(itemChanged(QStandardItem*)), this, SLOT(notifyModelModified()));
+	connect(this, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(notifyModelModified()));
 	connect(this, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(notifyBookmarkModified(QModelIndex)));
-	connect(this, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SIGNAL(modelModified()));
+	connect(this, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(notifyModelModified()));
 	connect(this, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(notifyBookmarkModified(QModelIndex)));
-	connect(this, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SIGNAL(modelModified()));
+	connect(this, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(notifyModelModified()));
+}
+
+void BookmarksModel::beginChanges()
+{
+	++m_changesDepth;
+}
+
+void BookmarksModel::endChanges()
+{
+	if (m_changesDepth == 0)
+	{
+		return;
+	}
+
+	--m_changesDepth;
+
+	if (m_changesDepth > 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < m_pendingParents.count(); ++i)
+	{
+		BookmarksItem *parent(m_pendingParents.at(i));
+		const QList<QStandardItem*> bookmarks(m_pendingBookmarks.value(parent));
+
+		parent->insertRows(parent->rowCount(), bookmarks);
+
+		for (int j = 0; j < bookmarks.count(); ++j)
+		{
+			commitBookmarks(static_cast<BookmarksItem*>(bookmarks.at(j)));
+		}
+	}
+
+	m_pendingBookmarks.clear();
+	m_pendingParents.clear();
+	m_pendingKeywords.clear();
+	m_pendingUrls.clear();
+
+	if (m_hasPendingChanges)
+	{
+		m_hasPendingChanges = false;
+
+		emit modelModified();
+	}
 }
 
 void BookmarksModel::trashBookmark(BookmarksItem *bookmark)
@@ -285,7 +341,7 @@ void BookmarksModel::trashBookmark(BookmarksItem *bookmark)
 
 			emit bookmarkModified(bookmark);
 			emit bookmarkTrashed(bookmark);
-			emit modelModified();
+			notifyModelModified();
 		}
 	}
 }
@@ -323,7 +379,7 @@ void BookmarksModel::restoreBookmark(BookmarksItem *bookmark)
 
 	emit bookmarkModified(bookmark);
 	emit bookmarkRestored(bookmark);
-	emit modelModified();
+	notifyModelModified();
 }
 
 void BookmarksModel::removeBookmark(BookmarksItem *bookmark)
@@ -335,23 +391,85 @@ void BookmarksModel::removeBookmark(BookmarksItem *bookmark)
 
 	removeBookmarkUrl(bookmark);
 
-	const quint64 identifier(bookmark->data(IdentifierRole).toULongLong());
+	QList<QStandardItem*> items({bookmark});
+	QList<QStandardItem*> pendingItems;
 
-	if (identifier > 0 && m_identifiers.contains(identifier))
+	while (!items.isEmpty())
 	{
-		m_identifiers.remove(identifier);
+		BookmarksItem *item(static_cast<BookmarksItem*>(items.takeLast()));
+
+		if (!item)
+		{
+			continue;
+		}
+
+		if (m_pendingBookmarks.contains(item))
+		{
+			const QList<QStandardItem*> children(m_pendingBookmarks.take(item));
+
+			m_pendingParents.removeAll(item);
+
+			items.append(children);
+			pendingItems.append(children);
+		}
+
+		const quint64 identifier(item->data(IdentifierRole).toULongLong());
+
+		if (identifier > 0 && m_identifiers.value(identifier) == item)
+		{
+			m_identifiers.remove(identifier);
+		}
+
+		const QString keyword(item->data(KeywordRole).toString());
+
+		if (!keyword.isEmpty() && m_keywords.value(keyword) == item)
+		{
+			m_keywords.remove(keyword);
+		}
+		else if (!keyword.isEmpty() && item->m_pendingModel == this)
+		{
+			updatePendingKeyword(keyword, QString());
+		}
+
+		for (int i = 0; i < item->rowCount(); ++i)
+		{
+			items.append(item->child(i, 0));
+		}
 	}
 
-	if (!bookmark->data(KeywordRole).toString().isEmpty() && m_keywords.contains(bookmark->data(KeywordRole).toString()))
+	qDeleteAll(pendingItems);
+
+	if (!bookmark->model())
 	{
-		m_keywords.remove(bookmark->data(KeywordRole).toString());
+		QHash<BookmarksItem*, QList<QStandardItem*> >::iterator iterator;
+
+		for (iterator = m_pendingBookmarks.begin(); iterator != m_pendingBookmarks.end(); ++iterator)
+		{
+			if (iterator.value().removeAll(bookmark) > 0)
+			{
+				delete bookmark;
+
+				return;
+			}
+		}
+
+		if (bookmark->parent())
+		{
+			bookmark->parent()->removeRow(bookmark->row());
+		}
+		else
+		{
+			delete bookmark;
+		}
+
+		return;
 	}
 
 	emit bookmarkRemoved(bookmark);
 
 	bookmark->parent()->removeRow(bookmark->row());
 
-	emit modelModified();
+	notifyModelModified();
 }
 
 void BookmarksModel::readBookmark(QXmlStreamReader *reader, BookmarksItem *parent)
@@ -659,6 +777,62 @@ void BookmarksModel::removeBookmarkUrl(BookmarksItem *bookmark)
 	}
 }
 
+void BookmarksModel::commitBookmarks(BookmarksItem *bookmark)
+{
+	const QString keyword(bookmark->data(KeywordRole).toString());
+
+	bookmark->m_pendingModel = nullptr;
+
+	if (!keyword.isEmpty())
+	{
+		if (m_keywords.contains(keyword))
+		{
+			bookmark->setItemData(QVariant(), KeywordRole);
+		}
+		else
+		{
+			m_keywords[keyword] = bookmark;
+		}
+	}
+
+	if (static_cast<BookmarkType>(bookmark->data(TypeRole).toInt()) == FolderBookmark)
+	{
+		for (int i = 0; i < bookmark->rowCount(); ++i)
+		{
+			BookmarksItem *child(static_cast<BookmarksItem*>(bookmark->child(i, 0)));
+
+			if (child)
+			{
+				commitBookmarks(child);
+			}
+		}
+	}
+	else if (!bookmark->data(UrlRole).toUrl().isEmpty())
+	{
+		m_urls[Utils::normalizeUrl(bookmark->data(UrlRole).toUrl())].append(bookmark);
+	}
+
+	emit bookmarkAdded(bookmark);
+}
+
+void BookmarksModel::updatePendingKeyword(const QString &oldKeyword, const QString &newKeyword)
+{
+	if (!oldKeyword.isEmpty() && m_pendingKeywords.contains(oldKeyword))
+	{
+		--m_pendingKeywords[oldKeyword];
+
+		if (m_pendingKeywords[oldKeyword] <= 0)
+		{
+			m_pendingKeywords.remove(oldKeyword);
+		}
+	}
+
+	if (!newKeyword.isEmpty())
+	{
+		++m_pendingKeywords[newKeyword];
+	}
+}
+
 void BookmarksModel::readdBookmarkUrl(BookmarksItem *bookmark)
 {
 	if (!bookmark)
@@ -694,7 +868,7 @@ void BookmarksModel::emptyTrash()
 
 	m_trash.clear();
 
-	emit modelModified();
+	notifyModelModified();
 }
 
 void BookmarksModel::notifyBookmarkModified(const QModelIndex &index)
@@ -707,28 +881,30 @@ void BookmarksModel::notifyBookmarkModified(const QModelIndex &index)
 	}
 }
 
-BookmarksItem* BookmarksModel::addBookmark(BookmarkType type, quint64 identifier, const QUrl &url, const QString &title, BookmarksItem *parent, int index)
+void BookmarksModel::notifyModelModified()
 {
-	BookmarksItem *bookmark(new BookmarksItem());
-
-	if (parent)
+	if (m_changesDepth > 0)
 	{
-		parent->insertRow(((index < 0) ? parent->rowCount() : index), bookmark);
+		m_hasPendingChanges = true;
 	}
 	else
 	{
-		getRootItem()->insertRow(((index < 0) ? getRootItem()->rowCount() : index), bookmark);
+		emit modelModified();
 	}
+}
+
+BookmarksItem* BookmarksModel::addBookmark(BookmarkType type, quint64 identifier, const QUrl &url, const QString &title, BookmarksItem *parent, int index)
+{
+	BookmarksItem *bookmark(new BookmarksItem());
+	bookmark->setItemData(type, TypeRole);
+	bookmark->setItemData(url, UrlRole);
+	bookmark->setItemData(title, TitleRole);
 
 	if (type == UrlBookmark || type == SeparatorBookmark)
 	{
 		bookmark->setDropEnabled(false);
 	}
 
-	setData(bookmark->index(), type, TypeRole);
-	setData(bookmark->index(), url, UrlRole);
-	setData(bookmark->index(), title, TitleRole);
-
 	if (type != RootBookmark && type != TrashBookmark && type != FolderBookmark)
 	{
 		bookmark->setFlags(bookmark->flags() | Qt::ItemNeverHasChildren);
@@ -738,16 +914,57 @@ BookmarksItem* BookmarksModel::addBookmark(BookmarkType type, quint64 identifier
 	{
 		if (identifier == 0 || m_identifiers.contains(identifier))
 		{
-			identifier = (m_identifiers.isEmpty() ? 1 : (m_identifiers.keys().last() + 1));
+			identifier = (m_identifiers.isEmpty() ? 1 : (m_identifiers.lastKey() + 1));
 		}
 
-		setData(bookmark->index(), identifier, IdentifierRole);
+		bookmark->setItemData(identifier, IdentifierRole);
 
 		m_identifiers[identifier] = bookmark;
 	}
 
+	if (!parent)
+	{
+		parent = getRootItem();
+	}
+
+	if (parent->model() != this || (m_changesDepth > 0 && index < 0))
+	{
+		bookmark->m_pendingModel = this;
+
+		if (parent->model() == this)
+		{
+			if (!m_pendingBookmarks.contains(parent))
+			{
+				m_pendingParents.append(parent);
+			}
+
+			m_pendingBookmarks[parent].append(bookmark);
+		}
+		else
+		{
+			parent->insertRow(((index < 0) ? parent->rowCount() : index), bookmark);
+		}
+
+		if (!url.isEmpty())
+		{
+			m_pendingUrls.insert(Utils::normalizeUrl(url));
+		}
+
+		notifyModelModified();
+
+		return bookmark;
+	}
+
+	parent->insertRow(((index < 0) ? parent->rowCount() : index), bookmark);
+
+	if (!url.isEmpty())
+	{
+		m_urls[Utils::normalizeUrl(url)].append(bookmark);
+	}
+
 	emit bookmarkAdded(bookmark);
-	emit modelModified();
+
+	notifyModelModified();
 
 	return bookmark;
 }
@@ -1002,7 +1219,7 @@ bool BookmarksModel::moveBookmark(BookmarksItem *bookmark, BookmarksItem *newPar
 			newParent->insertRow(newRow, bookmark);
 		}
 
-		emit modelModified();
+		notifyModelModified();
 
 		return true;
 	}
@@ -1014,7 +1231,7 @@ bool BookmarksModel::moveBookmark(BookmarksItem *bookmark, BookmarksItem *newPar
 		newParent->appendRow(bookmark->parent()->takeRow(bookmark->row()));
 
 		emit bookmarkMoved(bookmark, previousParent, previousRow);
-		emit modelModified();
+		notifyModelModified();
 
 		return true;
 	}
@@ -1029,7 +1246,7 @@ bool BookmarksModel::moveBookmark(BookmarksItem *bookmark, BookmarksItem *newPar
 	newParent->insertRow(targetRow, bookmark->parent()->takeRow(bookmark->row()));
 
 	emit bookmarkMoved(bookmark, previousParent, previousRow);
-	emit modelModified();
+	notifyModelModified();
 
 	return true;
 }
@@ -1067,6 +1284,8 @@ bool BookmarksModel::dropMimeData(const QMimeData *data, Qt::DropAction action,
 
 bool BookmarksModel::save(const QString &path) const
 {
+	MEERKAT_TRACE_FUNCTION("bookmarks");
+
 	if (SessionsManager::isReadOnly())
 	{
 		return false;
@@ -1170,7 +1389,7 @@ bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, in
 		case TimeVisitedRole:
 		case VisitsRole:
 			emit bookmarkModified(bookmark);
-			emit modelModified();
+			notifyModelModified();
 
 			break;
 	}
@@ -1180,12 +1399,14 @@ bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, in
 
 bool BookmarksModel::hasBookmark(const QUrl &url) const
 {
-	return m_urls.contains(Utils::normalizeUrl(url));
+	const QUrl normalizedUrl(Utils::normalizeUrl(url));
+
+	return (m_urls.contains(normalizedUrl) || m_pendingUrls.contains(normalizedUrl));
 }
 
 bool BookmarksModel::hasKeyword(const QString &keyword) const
 {
-	return m_keywords.contains(keyword);
+	return (m_keywords.contains(keyword) || m_pendingKeywords.contains(keyword));
 }
 
 }
@@ -20,6 +20,7 @@
 #ifndef MEERKAT_BOOKMARKSMODEL_H
 #define MEERKAT_BOOKMARKSMODEL_H
 
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtCore/QXmlStreamReader>
 #include <QtCore/QXmlStreamWriter>
@@ -28,6 +29,8 @@
 namespace Meerkat
 {
 
+class BookmarksModel;
+
 class BookmarksItem : public QStandardItem
 {
 public:
@@ -41,6 +44,9 @@ public:
 protected:
 	explicit BookmarksItem();
 
+private:
+	BookmarksModel *m_pendingModel;
+
 friend class BookmarksModel;
 };
 
@@ -89,6 +95,8 @@ public:
 
 	explicit BookmarksModel(const QString &path, FormatMode mode, QObject *parent = nullptr);
 
+	void beginChanges();
+	void endChanges();
 	void trashBookmark(BookmarksItem *bookmark);
 	void restoreBookmark(BookmarksItem *bookmark);
 	void removeBookmark(BookmarksItem *bookmark);
@@ -121,18 +129,27 @@ protected:
 	void writeBookmark(QXmlStreamWriter *writer, QStandardItem *bookmark) const;
 	void removeBookmarkUrl(BookmarksItem *bookmark);
 	void readdBookmarkUrl(BookmarksItem *bookmark);
+	void commitBookmarks(BookmarksItem *bookmark);
+	void updatePendingKeyword(const QString &oldKeyword, const QString &newKeyword);
 
 protected slots:
 	void notifyBookmarkModified(const QModelIndex &index);
+	void notifyModelModified();
 
 private:
 	BookmarksItem *m_rootItem;
 	BookmarksItem *m_trashItem;
 	QHash<BookmarksItem*, QPair<QModelIndex, int> > m_trash;
+	QHash<BookmarksItem*, QList<QStandardItem*> > m_pendingBookmarks;
+	QList<BookmarksItem*> m_pendingParents;
+	QHash<QString, int> m_pendingKeywords;
+	QSet<QUrl> m_pendingUrls;
 	QHash<QUrl, QList<BookmarksItem*> > m_urls;
 	QHash<QString, BookmarksItem*> m_keywords;
 	QMap<quint64, BookmarksItem*> m_identifiers;
 	FormatMode m_mode;
+	int m_changesDepth;
+	bool m_hasPendingChanges;
 
 signals:
 	void bookmarkAdded(BookmarksItem *bookmark);
@@ -19,11 +19,18 @@
 
 #include "Console.h"
 
+#include <QtCore/QMetaObject>
+
+#define MESSAGES_LIMIT 1000
+
 namespace Meerkat
 {
 
 Console* Console::m_instance(nullptr);
-QList<Console::Message> Console::m_messages;
+QVector<Console::Message> Console::m_messages;
+QMutex Console::m_mutex;
+QAtomicInt Console::m_isNotificationPending(0);
+quint64 Console::m_identifier(0);
 
 Console::Console(QObject *parent) : QObject(parent)
 {
@@ -38,24 +45,50 @@ void Console::createInstance(QObject *parent)
 }
 
 void Console::addMessage(const QString &note, MessageCategory category, MessageLevel level, const QString &source, int line, quint64 window)
+{
+	addMessage(note, QStringList(), category, level, source, line, window);
+}
+
+void Console::addMessage(const QString &note, const QStringList &arguments, MessageCategory category, MessageLevel level, const QString &source, int line, quint64 window)
 {
 	Message message;
-	message.time = QDateTime::currentDateTime();
 	message.note = note;
+	message.arguments = arguments;
 	message.source = source;
 	message.category = category;
 	message.level = level;
+	message.time = QDateTime::currentMSecsSinceEpoch();
 	message.line = line;
 	message.window = window;
 
-	m_messages.append(message);
+	QMutexLocker locker(&m_mutex);
 
-	if (m_messages.count() > 1000)
+	++m_identifier;
+
+	message.identifier = m_identifier;
+
+	if (m_messages.count() < MESSAGES_LIMIT)
+	{
+		m_messages.append(message);
+	}
+	else
 	{
-		m_messages.removeFirst();
+		m_messages[int((m_identifier - 1) % MESSAGES_LIMIT)] = message;
 	}
 
-	emit m_instance->messageAdded(message);
+	locker.unlock();
+
+	if (m_instance && m_isNotificationPending.testAndSetOrdered(0, 1))
+	{
+		QMetaObject::invokeMethod(m_instance, "notifyMessagesAdded", Qt::QueuedConnection);
+	}
+}
+
+void Console::notifyMessagesAdded()
+{
+	m_isNotificationPending.store(0);
+
+	emit messagesAdded();
 }
 
 Console* Console::getInstance()
@@ -63,9 +96,53 @@ Console* Console::getInstance()
 	return m_instance;
 }
 
-QList<Console::Message> Console::getMessages()
+QString Console::Message::getNote() const
+{
+	QString result(note);
+
+	for (int i = 0; i < arguments.count(); i += 4)
+	{
+		switch (qMin(4, (arguments.count() - i)))
+		{
+			case 1:
+				result = result.arg(arguments.at(i));
+
+				break;
+			case 2:
+				result = result.arg(arguments.at(i), arguments.at(i + 1));
+
+				break;
+			case 3:
+				result = result.arg(arguments.at(i), arguments.at(i + 1), arguments.at(i + 2));
+
+				break;
+			default:
+				result = result.arg(arguments.at(i), arguments.at(i + 1), arguments.at(i + 2), arguments.at(i + 3));
+
+				break;
+		}
+	}
+
+	return result;
+}
+
+QDateTime Console::Message::getTime() const
+{
+	return QDateTime::fromMSecsSinceEpoch(time);
+}
+
+QList<Console::Message> Console::getMessages(quint64 after)
 {
-	return m_messages;
+	QMutexLocker locker(&m_mutex);
+	QList<Message> messages;
+	const quint64 first(qMax((after + 1), (m_identifier - quint64(m_messages.count()) + 1)));
+
+	for (quint64 identifier = first; identifier <= m_identifier; ++identifier)
+	{
+		messages.append(m_messages.at(int((identifier - 1) % MESSAGES_LIMIT)));
+	}
+
+	return messages;
 }
 
 }
@@ -20,8 +20,12 @@
 #ifndef MEERKAT_CONSOLE_H
 #define MEERKAT_CONSOLE_H
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QDateTime>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
 
 namespace Meerkat
 {
@@ -52,29 +56,41 @@ public:
 
 	struct Message
 	{
-		QDateTime time;
 		QString note;
+		QStringList arguments;
 		QString source;
 		MessageCategory category = OtherCategory;
 		MessageLevel level = UnknownLevel;
+		qint64 time = 0;
+		quint64 identifier = 0;
 		quint64 window = 0;
 		int line = -1;
+
+		QString getNote() const;
+		QDateTime getTime() const;
 	};
 
 	static void createInstance(QObject *parent = nullptr);
 	static void addMessage(const QString &note, MessageCategory category, MessageLevel level, const QString &source = QString(), int line = -1, quint64 window = 0);
+	static void addMessage(const QString &note, const QStringList &arguments, MessageCategory category, MessageLevel level, const QString &source = QString(), int line = -1, quint64 window = 0);
 	static Console* getInstance();
-	static QList<Message> getMessages();
+	static QList<Message> getMessages(quint64 after = 0);
 
 protected:
 	explicit Console(QObject *parent = nullptr);
 
+protected slots:
+	void notifyMessagesAdded();
+
 private:
 	static Console *m_instance;
-	static QList<Message> m_messages;
+	static QVector<Message> m_messages;
+	static QMutex m_mutex;
+	static QAtomicInt m_isNotificationPending;
+	static quint64 m_identifier;
 
 signals:
-	void messageAdded(const Console::Message &message);
+	void messagesAdded();
 };
 
 }
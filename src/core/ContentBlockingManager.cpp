@@ -23,6 +23,7 @@
 #include "ContentBlockingProfile.h"
 #include "SettingsManager.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
 #include "Utils.h"
 
 #include <QtCore/QDir>
@@ -51,6 +52,8 @@ ContentBlockingManager::ContentBlockingManager(QObject *parent) : QObject(parent
 
 void ContentBlockingManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new ContentBlockingManager(parent);
@@ -285,6 +288,8 @@ ContentBlockingProfile* ContentBlockingManager::getProfile(const QString &profil
 
 ContentBlockingManager::CheckResult ContentBlockingManager::checkUrl(const QVector<int> &profiles, const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType)
 {
+	MEERKAT_TRACE_FUNCTION("contentblocking");
+
 	if (profiles.isEmpty())
 	{
 		return CheckResult();
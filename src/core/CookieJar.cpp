@@ -34,6 +34,7 @@ CookieJar::CookieJar(bool isPrivate, QObject *parent) : QNetworkCookieJar(parent
 	m_thirdPartyCookiesPolicy(AcceptAllCookies),
 	m_keepMode(KeepUntilExpiresMode),
 	m_saveTimer(0),
+	m_logSize(0),
 	m_isPrivate(isPrivate)
 {
 	if (isPrivate)
@@ -43,38 +44,75 @@ CookieJar::CookieJar(bool isPrivate, QObject *parent) : QNetworkCookieJar(parent
 
 	QFile file(SessionsManager::getWritableDataPath(QLatin1String("cookies.dat")));
 
-	if (!file.open(QIODevice::ReadOnly))
+	if (file.open(QIODevice::ReadOnly))
 	{
-		return;
-	}
+		QDataStream stream(&file);
+		quint32 amount;
 
-	QList<QNetworkCookie> allCookies;
-	QDataStream stream(&file);
-	quint32 amount;
+		stream >> amount;
 
-	stream >> amount;
+		for (quint32 i = 0; i < amount; ++i)
+		{
+			QByteArray value;
 
-	for (quint32 i = 0; i < amount; ++i)
-	{
-		QByteArray value;
+			stream >> value;
 
-		stream >> value;
+			const QList<QNetworkCookie> cookies(QNetworkCookie::parseCookies(value));
 
-		const QList<QNetworkCookie> cookies(QNetworkCookie::parseCookies(value));
+			for (int j = 0; j < cookies.count(); ++j)
+			{
+				storeCookie(cookies.at(j));
+			}
 
-		for (int j = 0; j < cookies.count(); ++j)
-		{
-			allCookies.append(cookies.at(j));
+			if (stream.atEnd())
+			{
+				break;
+			}
 		}
 
-		if (stream.atEnd())
+		file.close();
+	}
+
+	QFile logFile(SessionsManager::getWritableDataPath(QLatin1String("cookies.log")));
+
+	if (logFile.open(QIODevice::ReadOnly))
+	{
+		QDataStream stream(&logFile);
+
+		while (!stream.atEnd())
 		{
-			break;
+			quint8 operation;
+			QByteArray value;
+
+			stream >> operation >> value;
+
+			if (stream.status() != QDataStream::Ok)
+			{
+				break;
+			}
+
+			const QList<QNetworkCookie> cookies(QNetworkCookie::parseCookies(value));
+
+			for (int i = 0; i < cookies.count(); ++i)
+			{
+				if (static_cast<CookieOperation>(operation) == RemoveCookie)
+				{
+					removeCookie(cookies.at(i));
+				}
+				else
+				{
+					removeCookie(cookies.at(i));
+					storeCookie(cookies.at(i));
+				}
+			}
+
+			++m_logSize;
 		}
+
+		logFile.close();
 	}
 
 	optionChanged(SettingsManager::Network_CookiesPolicyOption, SettingsManager::getValue(SettingsManager::Network_CookiesPolicyOption));
-	setAllCookies(allCookies);
 
 	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int,QVariant)));
 }
@@ -124,21 +162,34 @@ void CookieJar::clearCookies(int period)
 {
 	Q_UNUSED(period)
 
-	const QList<QNetworkCookie> cookies(allCookies());
+	const QList<QNetworkCookie> cookies(getCookies());
+
+	m_cookies.clear();
+	m_pendingOperations.clear();
 
 	for (int i = 0; i < cookies.count(); ++i)
 	{
-		QNetworkCookieJar::deleteCookie(cookies.at(i));
-
 		emit cookieRemoved(cookies.at(i));
 	}
 
-	save();
+	compact();
 }
 
-void CookieJar::scheduleSave()
+void CookieJar::scheduleSave(CookieOperation operation, const QNetworkCookie &cookie)
 {
-	if (!m_isPrivate && m_saveTimer == 0)
+	if (m_isPrivate)
+	{
+		return;
+	}
+
+	if (cookie.isSessionCookie())
+	{
+		operation = RemoveCookie;
+	}
+
+	m_pendingOperations[cookie.domain().toUtf8() + ';' + cookie.path().toUtf8() + ';' + cookie.name()] = qMakePair(operation, cookie);
+
+	if (m_saveTimer == 0)
 	{
 		m_saveTimer = startTimer(500);
 	}
@@ -146,7 +197,52 @@ void CookieJar::scheduleSave()
 
 void CookieJar::save()
 {
-	if (SessionsManager::isReadOnly())
+	if (SessionsManager::isReadOnly() || m_pendingOperations.isEmpty())
+	{
+		return;
+	}
+
+	QFile file(SessionsManager::getWritableDataPath(QLatin1String("cookies.log")));
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		return;
+	}
+
+	QDataStream stream(&file);
+	QHash<QByteArray, QPair<CookieOperation, QNetworkCookie> >::const_iterator iterator;
+
+	for (iterator = m_pendingOperations.constBegin(); iterator != m_pendingOperations.constEnd(); ++iterator)
+	{
+		stream << quint8(iterator.value().first) << iterator.value().second.toRawForm();
+
+		++m_logSize;
+	}
+
+	file.close();
+
+	m_pendingOperations.clear();
+
+	if (m_logSize > 1000)
+	{
+		int amount(0);
+		QHash<QString, QList<QNetworkCookie> >::const_iterator cookiesIterator;
+
+		for (cookiesIterator = m_cookies.constBegin(); cookiesIterator != m_cookies.constEnd(); ++cookiesIterator)
+		{
+			amount += cookiesIterator.value().count();
+		}
+
+		if (m_logSize > amount)
+		{
+			compact();
+		}
+	}
+}
+
+void CookieJar::compact()
+{
+	if (m_isPrivate || SessionsManager::isReadOnly())
 	{
 		return;
 	}
@@ -158,25 +254,63 @@ void CookieJar::save()
 		return;
 	}
 
-	const QList<QNetworkCookie> cookies(allCookies());
+	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
+	QList<QNetworkCookie> cookies;
+	QHash<QString, QList<QNetworkCookie> >::iterator iterator(m_cookies.begin());
+
+	while (iterator != m_cookies.end())
+	{
+		QList<QNetworkCookie> &domainCookies(iterator.value());
+
+		for (int i = (domainCookies.count() - 1); i >= 0; --i)
+		{
+			if (domainCookies.at(i).isSessionCookie())
+			{
+				continue;
+			}
+
+			if (domainCookies.at(i).expirationDate() < currentDateTime)
+			{
+				domainCookies.removeAt(i);
+			}
+			else
+			{
+				cookies.append(domainCookies.at(i));
+			}
+		}
+
+		if (domainCookies.isEmpty())
+		{
+			iterator = m_cookies.erase(iterator);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+
 	QDataStream stream(&file);
 	stream << quint32(cookies.count());
 
 	for (int i = 0; i < cookies.count(); ++i)
 	{
-		if (!cookies.at(i).isSessionCookie())
-		{
-			stream << cookies.at(i).toRawForm();
-		}
+		stream << cookies.at(i).toRawForm();
 	}
 
-	file.commit();
+	if (file.commit())
+	{
+		QFile::remove(SessionsManager::getWritableDataPath(QLatin1String("cookies.log")));
+
+		m_pendingOperations.clear();
+
+		m_logSize = 0;
+	}
 }
 
 CookieJar* CookieJar::clone(QObject *parent)
 {
 	CookieJar *cookieJar(new CookieJar(m_isPrivate, parent));
-	cookieJar->setAllCookies(allCookies());
+	cookieJar->m_cookies = m_cookies;
 
 	return cookieJar;
 }
@@ -188,33 +322,96 @@ QList<QNetworkCookie> CookieJar::cookiesForUrl(const QUrl &url) const
 		return QList<QNetworkCookie>();
 	}
 
-	return QNetworkCookieJar::cookiesForUrl(url);
+	return getCookiesForUrl(url);
 }
 
 QList<QNetworkCookie> CookieJar::getCookiesForUrl(const QUrl &url) const
 {
-	return QNetworkCookieJar::cookiesForUrl(url);
+	const QString host(url.host());
+
+	if (host.isEmpty() || !m_cookies.contains(getDomainKey(host)))
+	{
+		return QList<QNetworkCookie>();
+	}
+
+	const QList<QNetworkCookie> cookies(m_cookies.value(getDomainKey(host)));
+	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
+	const QString path(url.path());
+	const bool isEncrypted(url.scheme() == QLatin1String("https") || url.scheme() == QLatin1String("wss"));
+	QList<QNetworkCookie> urlCookies;
+
+	for (int i = 0; i < cookies.count(); ++i)
+	{
+		const QNetworkCookie &cookie(cookies.at(i));
+
+		if (!isParentDomain(host, cookie.domain()) || !isParentPath(path, cookie.path()) || (cookie.isSecure() && !isEncrypted) || (!cookie.isSessionCookie() && cookie.expirationDate() < currentDateTime))
+		{
+			continue;
+		}
+
+		QList<QNetworkCookie>::iterator iterator(urlCookies.begin());
+
+		while (iterator != urlCookies.end() && iterator->path().length() >= cookie.path().length())
+		{
+			++iterator;
+		}
+
+		urlCookies.insert(iterator, cookie);
+	}
+
+	return urlCookies;
 }
 
 QList<QNetworkCookie> CookieJar::getCookies(const QString &domain) const
 {
+	const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
+	QList<QNetworkCookie> cookies;
+
 	if (!domain.isEmpty())
 	{
-		const QList<QNetworkCookie> cookies(allCookies());
-		QList<QNetworkCookie> domainCookies;
+		const QList<QNetworkCookie> domainCookies(m_cookies.value(getDomainKey(domain)));
+
+		for (int i = 0; i < domainCookies.count(); ++i)
+		{
+			if ((domainCookies.at(i).isSessionCookie() || domainCookies.at(i).expirationDate() >= currentDateTime) && (domainCookies.at(i).domain() == domain || (domainCookies.at(i).domain().startsWith(QLatin1Char('.')) && domain.endsWith(domainCookies.at(i).domain()))))
+			{
+				cookies.append(domainCookies.at(i));
+			}
+		}
+
+		return cookies;
+	}
 
-		for (int i = 0; i < cookies.count(); ++i)
+	QHash<QString, QList<QNetworkCookie> >::const_iterator iterator;
+
+	for (iterator = m_cookies.constBegin(); iterator != m_cookies.constEnd(); ++iterator)
+	{
+		for (int i = 0; i < iterator.value().count(); ++i)
 		{
-			if (cookies.at(i).domain() == domain || (cookies.at(i).domain().startsWith(QLatin1Char('.')) && domain.endsWith(cookies.at(i).domain())))
+			if (iterator.value().at(i).isSessionCookie() || iterator.value().at(i).expirationDate() >= currentDateTime)
 			{
-				domainCookies.append(cookies.at(i));
+				cookies.append(iterator.value().at(i));
 			}
 		}
+	}
 
-		return domainCookies;
+	return cookies;
+}
+
+QString CookieJar::getDomainKey(const QString &domain)
+{
+	const QString host((domain.startsWith(QLatin1Char('.')) ? domain.mid(1) : domain).toLower());
+	QUrl url;
+	url.setHost(host);
+
+	const QString topLevelDomain(url.topLevelDomain());
+
+	if (topLevelDomain.isEmpty() || topLevelDomain.length() > host.length())
+	{
+		return host;
 	}
 
-	return allCookies();
+	return host.left(host.length() - topLevelDomain.length()).section(QLatin1Char('.'), -1) + topLevelDomain;
 }
 
 bool CookieJar::insertCookie(const QNetworkCookie &cookie)
@@ -224,102 +421,132 @@ bool CookieJar::insertCookie(const QNetworkCookie &cookie)
 		return false;
 	}
 
-	const bool result(QNetworkCookieJar::insertCookie(cookie));
+	return forceInsertCookie(cookie);
+}
 
-	if (result)
+bool CookieJar::updateCookie(const QNetworkCookie &cookie)
+{
+	if (m_generalCookiesPolicy == IgnoreCookies || m_generalCookiesPolicy == ReadOnlyCookies)
 	{
-		scheduleSave();
-
-		emit cookieAdded(cookie);
+		return false;
 	}
 
-	return result;
+	return forceUpdateCookie(cookie);
 }
 
-bool CookieJar::updateCookie(const QNetworkCookie &cookie)
+bool CookieJar::deleteCookie(const QNetworkCookie &cookie)
 {
 	if (m_generalCookiesPolicy == IgnoreCookies || m_generalCookiesPolicy == ReadOnlyCookies)
 	{
 		return false;
 	}
 
-	const bool result(QNetworkCookieJar::updateCookie(cookie));
+	return forceDeleteCookie(cookie);
+}
+
+bool CookieJar::forceInsertCookie(const QNetworkCookie &cookie)
+{
+	const bool hasRemoved(removeCookie(cookie));
 
-	if (result)
+	if (!storeCookie(cookie))
 	{
-		scheduleSave();
+		if (hasRemoved)
+		{
+			scheduleSave(RemoveCookie, cookie);
+
+			emit cookieRemoved(cookie);
+		}
+
+		return true;
 	}
 
-	return result;
+	scheduleSave(InsertCookie, cookie);
+
+	emit cookieAdded(cookie);
+
+	return true;
 }
 
-bool CookieJar::deleteCookie(const QNetworkCookie &cookie)
+bool CookieJar::forceUpdateCookie(const QNetworkCookie &cookie)
 {
-	if (m_generalCookiesPolicy == IgnoreCookies || m_generalCookiesPolicy == ReadOnlyCookies)
+	if (!removeCookie(cookie))
 	{
 		return false;
 	}
 
-	const bool result(QNetworkCookieJar::deleteCookie(cookie));
-
-	if (result)
+	if (!storeCookie(cookie))
 	{
-		scheduleSave();
+		scheduleSave(RemoveCookie, cookie);
 
 		emit cookieRemoved(cookie);
+
+		return true;
 	}
 
-	return result;
+	scheduleSave(UpdateCookie, cookie);
+
+	return true;
 }
 
-bool CookieJar::forceInsertCookie(const QNetworkCookie &cookie)
+bool CookieJar::forceDeleteCookie(const QNetworkCookie &cookie)
 {
-	const bool result(QNetworkCookieJar::insertCookie(cookie));
-
-	if (result)
+	if (!removeCookie(cookie))
 	{
-		scheduleSave();
-
-		emit cookieAdded(cookie);
+		return false;
 	}
 
-	return result;
+	scheduleSave(RemoveCookie, cookie);
+
+	emit cookieRemoved(cookie);
+
+	return true;
 }
 
-bool CookieJar::forceUpdateCookie(const QNetworkCookie &cookie)
+bool CookieJar::storeCookie(const QNetworkCookie &cookie)
 {
-	const bool result(QNetworkCookieJar::updateCookie(cookie));
-
-	if (result)
+	if (!cookie.isSessionCookie() && cookie.expirationDate() < QDateTime::currentDateTimeUtc())
 	{
-		scheduleSave();
+		return false;
 	}
 
-	return result;
+	m_cookies[getDomainKey(cookie.domain())].append(cookie);
+
+	return true;
 }
 
-bool CookieJar::forceDeleteCookie(const QNetworkCookie &cookie)
+bool CookieJar::removeCookie(const QNetworkCookie &cookie)
 {
-	const bool result(QNetworkCookieJar::deleteCookie(cookie));
+	const QString key(getDomainKey(cookie.domain()));
 
-	if (result)
+	if (!m_cookies.contains(key))
 	{
-		scheduleSave();
+		return false;
+	}
 
-		emit cookieRemoved(cookie);
+	QList<QNetworkCookie> &cookies(m_cookies[key]);
+	bool hasFound(false);
+
+	for (int i = (cookies.count() - 1); i >= 0; --i)
+	{
+		if (cookies.at(i).hasSameIdentifier(cookie))
+		{
+			cookies.removeAt(i);
+
+			hasFound = true;
+		}
+	}
+
+	if (cookies.isEmpty())
+	{
+		m_cookies.remove(key);
 	}
 
-	return result;
+	return hasFound;
 }
 
 bool CookieJar::hasCookie(const QNetworkCookie &cookie) const
 {
-	QUrl url;
-	url.setScheme(cookie.isSecure() ? QLatin1String("https") : QLatin1String("http"));
-	url.setHost(cookie.domain().startsWith(QLatin1Char('.')) ? cookie.domain().mid(1) : cookie.domain());
-	url.setPath(cookie.path());
-
-	const QList<QNetworkCookie> cookies(getCookiesForUrl(url));
+	const QList<QNetworkCookie> cookies(m_cookies.value(getDomainKey(cookie.domain())));
 
 	for (int i = 0; i < cookies.count(); ++i)
 	{
@@ -332,6 +559,26 @@ bool CookieJar::hasCookie(const QNetworkCookie &cookie) const
 	return false;
 }
 
+bool CookieJar::isParentDomain(const QString &domain, const QString &reference)
+{
+	if (!reference.startsWith(QLatin1Char('.')))
+	{
+		return (domain == reference);
+	}
+
+	return (domain.endsWith(reference) || domain == reference.mid(1));
+}
+
+bool CookieJar::isParentPath(const QString &path, const QString &reference)
+{
+	if ((path.isEmpty() && reference == QLatin1String("/")) || path.startsWith(reference))
+	{
+		return (path.length() == reference.length() || reference.endsWith(QLatin1Char('/')) || path.at(reference.length()) == QLatin1Char('/'));
+	}
+
+	return false;
+}
+
 bool CookieJar::isDomainTheSame(const QUrl &first, const QUrl &second)
 {
 	const QString firstTld(first.topLevelDomain());
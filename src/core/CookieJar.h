@@ -20,6 +20,7 @@
 #ifndef MEERKAT_COOKIEJAR_H
 #define MEERKAT_COOKIEJAR_H
 
+#include <QtCore/QHash>
 #include <QtNetwork/QNetworkCookie>
 #include <QtNetwork/QNetworkCookieJar>
 
@@ -71,17 +72,26 @@ public:
 
 protected:
 	void timerEvent(QTimerEvent *event);
-	void scheduleSave();
+	void scheduleSave(CookieOperation operation, const QNetworkCookie &cookie);
 	void save();
+	void compact();
+	bool storeCookie(const QNetworkCookie &cookie);
+	bool removeCookie(const QNetworkCookie &cookie);
+	static QString getDomainKey(const QString &domain);
+	static bool isParentDomain(const QString &domain, const QString &reference);
+	static bool isParentPath(const QString &path, const QString &reference);
 
 protected slots:
 	void optionChanged(int identifier, const QVariant &value);
 
 private:
+	QHash<QString, QList<QNetworkCookie> > m_cookies;
+	QHash<QByteArray, QPair<CookieOperation, QNetworkCookie> > m_pendingOperations;
 	CookiesPolicy m_generalCookiesPolicy;
 	CookiesPolicy m_thirdPartyCookiesPolicy;
 	KeepMode m_keepMode;
 	int m_saveTimer;
+	int m_logSize;
 	bool m_isPrivate;
 
 signals:
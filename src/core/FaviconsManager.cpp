@@ -0,0 +1,648 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "FaviconsManager.h"
+#include "SessionsManager.h"
+#include "SettingsManager.h"
+#include "Tracer.h"
+#include "Utils.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
+#include <QtCore/QTimerEvent>
+#include <QtGui/QPainter>
+
+#define FAVICONS_HOSTS_LIMIT 10000
+#define FAVICONS_PAGES_LIMIT 10000
+
+namespace Meerkat
+{
+
+FaviconIconEngine::FaviconIconEngine(quint32 image, quint32 generation) : QIconEngine(),
+	m_image(image),
+	m_generation(generation)
+{
+}
+
+void FaviconIconEngine::paint(QPainter *painter, const QRect &rectangle, QIcon::Mode mode, QIcon::State state)
+{
+	const QPixmap pixmap(this->pixmap(rectangle.size(), mode, state));
+
+	if (!pixmap.isNull())
+	{
+		painter->drawPixmap(rectangle, pixmap);
+	}
+}
+
+QIconEngine* FaviconIconEngine::clone() const
+{
+	return new FaviconIconEngine(m_image, m_generation);
+}
+
+QPixmap FaviconIconEngine::pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state)
+{
+	Q_UNUSED(mode)
+	Q_UNUSED(state)
+
+	const QPixmap pixmap(FaviconsManager::getPixmap(m_image, m_generation));
+
+	if (pixmap.isNull() || pixmap.size() == size)
+	{
+		return pixmap;
+	}
+
+	return pixmap.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+FaviconsManager* FaviconsManager::m_instance(nullptr);
+
+FaviconsManager::FaviconsManager(QObject *parent) : QObject(parent),
+	m_pixmaps(500),
+	m_dataFileName(QLatin1String("favicons.dat")),
+	m_data(nullptr),
+	m_dataSize(0),
+	m_generation(0),
+	m_saveTimer(0),
+	m_isEnabled(SettingsManager::getValue(SettingsManager::History_StoreFaviconsOption).toBool()),
+	m_isLoaded(false)
+{
+	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int,QVariant)));
+}
+
+FaviconsManager::~FaviconsManager()
+{
+	if (m_saveTimer != 0)
+	{
+		save();
+	}
+
+	unmapData();
+}
+
+void FaviconsManager::createInstance(QObject *parent)
+{
+	MEERKAT_TRACE_FUNCTION("startup");
+
+	if (!m_instance)
+	{
+		m_instance = new FaviconsManager(parent);
+	}
+}
+
+void FaviconsManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_saveTimer)
+	{
+		killTimer(m_saveTimer);
+
+		m_saveTimer = 0;
+
+		save();
+	}
+}
+
+void FaviconsManager::optionChanged(int identifier, const QVariant &value)
+{
+	if (identifier == SettingsManager::History_StoreFaviconsOption)
+	{
+		m_isEnabled = value.toBool();
+	}
+}
+
+void FaviconsManager::scheduleSave()
+{
+	if (m_saveTimer == 0 && !SessionsManager::isPrivate())
+	{
+		m_saveTimer = startTimer(1000);
+	}
+}
+
+void FaviconsManager::save()
+{
+	if (SessionsManager::isPrivate() || SessionsManager::isReadOnly())
+	{
+		return;
+	}
+
+	const QString previousDataFileName(m_dataFileName);
+
+	if (!compactData())
+	{
+		return;
+	}
+
+	if (!m_pendingData.isEmpty())
+	{
+		unmapData();
+
+		QFile file(SessionsManager::getWritableDataPath(m_dataFileName));
+		const bool isSuccessful(file.open(QIODevice::WriteOnly | QIODevice::Append) && file.size() == m_dataSize && file.write(m_pendingData) == m_pendingData.size());
+
+		file.close();
+
+		if (isSuccessful)
+		{
+			m_pendingData.clear();
+		}
+
+		mapData();
+
+		if (!isSuccessful)
+		{
+			return;
+		}
+	}
+
+	QSaveFile file(SessionsManager::getWritableDataPath(QLatin1String("favicons.index")));
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream << quint32(2) << m_dataFileName << quint32(m_images.count());
+
+	for (int i = 0; i < m_images.count(); ++i)
+	{
+		stream << m_images.at(i).hash << m_images.at(i).offset << m_images.at(i).size;
+	}
+
+	stream << m_hosts << m_pages;
+
+	if (file.commit() && m_dataFileName != previousDataFileName)
+	{
+		QFile::remove(SessionsManager::getWritableDataPath(previousDataFileName));
+	}
+}
+
+void FaviconsManager::load()
+{
+	if (m_isLoaded)
+	{
+		return;
+	}
+
+	m_isLoaded = true;
+
+	if (SessionsManager::isPrivate())
+	{
+		return;
+	}
+
+	QFile file(SessionsManager::getWritableDataPath(QLatin1String("favicons.index")));
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		mapData();
+
+		return;
+	}
+
+	QDataStream stream(&file);
+	quint32 version;
+	quint32 amount;
+
+	stream >> version;
+
+	if (version == 2)
+	{
+		stream >> m_dataFileName;
+	}
+	else if (version != 1)
+	{
+		mapData();
+
+		return;
+	}
+
+	stream >> amount;
+
+	if (stream.status() != QDataStream::Ok || m_dataFileName.isEmpty() || m_dataFileName.contains(QLatin1Char('/')))
+	{
+		m_dataFileName = QLatin1String("favicons.dat");
+	}
+
+	mapData();
+
+	m_images.reserve(amount);
+
+	for (quint32 i = 0; i < amount; ++i)
+	{
+		FaviconImage image;
+
+		stream >> image.hash >> image.offset >> image.size;
+
+		if (stream.status() != QDataStream::Ok || (image.offset + image.size) > quint64(m_dataSize))
+		{
+			break;
+		}
+
+		if (image.size > 0)
+		{
+			m_hashes[image.hash] = quint32(m_images.count());
+		}
+
+		m_images.append(image);
+	}
+
+	stream >> m_hosts >> m_pages;
+
+	if (stream.status() != QDataStream::Ok || quint32(m_images.count()) != amount)
+	{
+		m_hashes.clear();
+		m_hosts.clear();
+		m_pages.clear();
+		m_images.clear();
+	}
+}
+
+bool FaviconsManager::compactData()
+{
+	QSet<quint32> identifiers(m_hosts.values().toSet());
+	identifiers.unite(m_pages.values().toSet());
+
+	qint64 unusedSize(0);
+	qint64 usedSize(0);
+
+	for (int i = 0; i < m_images.count(); ++i)
+	{
+		if (identifiers.contains(quint32(i)))
+		{
+			usedSize += m_images.at(i).size;
+		}
+		else
+		{
+			unusedSize += m_images.at(i).size;
+		}
+	}
+
+	if (unusedSize == 0 || unusedSize < (usedSize / 4))
+	{
+		return true;
+	}
+
+	QVector<FaviconImage> images(m_images);
+	QByteArray data;
+	data.reserve(int(usedSize));
+
+	for (int i = 0; i < images.count(); ++i)
+	{
+		if (identifiers.contains(quint32(i)) && images.at(i).size > 0)
+		{
+			images[i].offset = quint64(data.size());
+
+			data.append(getImageData(quint32(i)));
+		}
+		else
+		{
+			images[i] = FaviconImage();
+		}
+	}
+
+	const QString dataFileName((m_dataFileName == QLatin1String("favicons.dat")) ? QLatin1String("favicons-compacted.dat") : QLatin1String("favicons.dat"));
+	QSaveFile file(SessionsManager::getWritableDataPath(dataFileName));
+
+	if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+	{
+		return false;
+	}
+
+	unmapData();
+
+	m_dataFileName = dataFileName;
+	m_images = images;
+	m_pendingData.clear();
+	m_hashes.clear();
+
+	for (int i = 0; i < m_images.count(); ++i)
+	{
+		if (m_images.at(i).size > 0)
+		{
+			m_hashes[m_images.at(i).hash] = quint32(i);
+		}
+	}
+
+	mapData();
+
+	return true;
+}
+
+void FaviconsManager::mapData()
+{
+	unmapData();
+
+	m_dataFile.setFileName(SessionsManager::getWritableDataPath(m_dataFileName));
+
+	if (!m_dataFile.open(QIODevice::ReadOnly))
+	{
+		m_dataSize = 0;
+
+		return;
+	}
+
+	m_dataSize = m_dataFile.size();
+
+	if (m_dataSize > 0)
+	{
+		m_data = m_dataFile.map(0, m_dataSize);
+	}
+}
+
+void FaviconsManager::unmapData()
+{
+	if (m_data)
+	{
+		m_dataFile.unmap(m_data);
+
+		m_data = nullptr;
+	}
+
+	m_dataFile.close();
+}
+
+void FaviconsManager::clearIcons()
+{
+	if (!m_instance)
+	{
+		return;
+	}
+
+	m_instance->load();
+	m_instance->unmapData();
+
+	++m_instance->m_generation;
+
+	m_instance->m_pixmaps.clear();
+	m_instance->m_icons.clear();
+	m_instance->m_hashes.clear();
+	m_instance->m_hosts.clear();
+	m_instance->m_pages.clear();
+	m_instance->m_images.clear();
+	m_instance->m_pendingData.clear();
+	m_instance->m_dataFileName = QLatin1String("favicons.dat");
+	m_instance->m_dataSize = 0;
+
+	if (!SessionsManager::isPrivate() && !SessionsManager::isReadOnly())
+	{
+		QFile::remove(SessionsManager::getWritableDataPath(QLatin1String("favicons.index")));
+		QFile::remove(SessionsManager::getWritableDataPath(QLatin1String("favicons.dat")));
+		QFile::remove(SessionsManager::getWritableDataPath(QLatin1String("favicons-compacted.dat")));
+	}
+}
+
+void FaviconsManager::removeIcons(const QList<QUrl> &urls, const QSet<QString> &retainedHosts)
+{
+	if (!m_instance || urls.isEmpty())
+	{
+		return;
+	}
+
+	m_instance->load();
+
+	QSet<QUrl> removedUrls;
+	QSet<QString> removedHosts;
+
+	for (int i = 0; i < urls.count(); ++i)
+	{
+		removedUrls.insert(Utils::normalizeUrl(urls.at(i)));
+
+		if (!retainedHosts.contains(urls.at(i).host()))
+		{
+			removedHosts.insert(urls.at(i).host());
+		}
+	}
+
+	bool isModified(false);
+	QHash<QString, quint32>::iterator pagesIterator(m_instance->m_pages.begin());
+
+	while (pagesIterator != m_instance->m_pages.end())
+	{
+		if (removedUrls.contains(Utils::normalizeUrl(QUrl(pagesIterator.key()))))
+		{
+			pagesIterator = m_instance->m_pages.erase(pagesIterator);
+
+			isModified = true;
+		}
+		else
+		{
+			++pagesIterator;
+		}
+	}
+
+	QSet<QString>::const_iterator hostsIterator;
+
+	for (hostsIterator = removedHosts.constBegin(); hostsIterator != removedHosts.constEnd(); ++hostsIterator)
+	{
+		if (m_instance->m_hosts.remove(*hostsIterator) > 0)
+		{
+			isModified = true;
+		}
+	}
+
+	if (isModified)
+	{
+		m_instance->scheduleSave();
+	}
+}
+
+void FaviconsManager::setIcon(const QUrl &url, const QIcon &icon)
+{
+	if (!m_instance || icon.isNull() || !url.isValid())
+	{
+		return;
+	}
+
+	m_instance->load();
+
+	QImage image(icon.pixmap(16, 16).toImage());
+
+	if (image.isNull())
+	{
+		return;
+	}
+
+	if (image.size() != QSize(16, 16))
+	{
+		image = image.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+	}
+
+	QByteArray data;
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::WriteOnly);
+
+	if (!image.save(&buffer, "PNG"))
+	{
+		return;
+	}
+
+	const QByteArray hash(QCryptographicHash::hash(data, QCryptographicHash::Md5));
+	quint32 identifier(0);
+
+	if (m_instance->m_hashes.contains(hash))
+	{
+		identifier = m_instance->m_hashes[hash];
+	}
+	else
+	{
+		FaviconImage faviconImage;
+		faviconImage.hash = hash;
+		faviconImage.offset = (m_instance->m_dataSize + m_instance->m_pendingData.size());
+		faviconImage.size = data.size();
+
+		identifier = quint32(m_instance->m_images.count());
+
+		m_instance->m_images.append(faviconImage);
+		m_instance->m_hashes[hash] = identifier;
+		m_instance->m_pendingData.append(data);
+	}
+
+	const QString host(url.host());
+	const QString page(getPageKey(url));
+	const bool isRoot(url.path().isEmpty() || url.path() == QLatin1String("/"));
+	bool isModified(false);
+
+	if (!host.isEmpty() && (isRoot || !m_instance->m_hosts.contains(host)) && m_instance->m_hosts.value(host, (identifier + 1)) != identifier)
+	{
+		if (m_instance->m_hosts.count() >= FAVICONS_HOSTS_LIMIT && !m_instance->m_hosts.contains(host))
+		{
+			m_instance->m_hosts.erase(m_instance->m_hosts.begin());
+		}
+
+		m_instance->m_hosts[host] = identifier;
+
+		isModified = true;
+	}
+
+	if (!host.isEmpty() && m_instance->m_hosts.value(host) == identifier)
+	{
+		if (m_instance->m_pages.remove(page) > 0)
+		{
+			isModified = true;
+		}
+	}
+	else if (m_instance->m_pages.value(page, (identifier + 1)) != identifier)
+	{
+		if (m_instance->m_pages.count() >= FAVICONS_PAGES_LIMIT && !m_instance->m_pages.contains(page))
+		{
+			m_instance->m_pages.erase(m_instance->m_pages.begin());
+		}
+
+		m_instance->m_pages[page] = identifier;
+
+		isModified = true;
+	}
+
+	if (isModified)
+	{
+		m_instance->scheduleSave();
+	}
+}
+
+FaviconsManager* FaviconsManager::getInstance()
+{
+	return m_instance;
+}
+
+QByteArray FaviconsManager::getImageData(quint32 image)
+{
+	const FaviconImage &faviconImage(m_images.at(image));
+
+	if (faviconImage.offset >= quint64(m_dataSize))
+	{
+		return m_pendingData.mid(int(faviconImage.offset - m_dataSize), int(faviconImage.size));
+	}
+
+	if (m_data)
+	{
+		return QByteArray(reinterpret_cast<const char*>(m_data + faviconImage.offset), int(faviconImage.size));
+	}
+
+	if (m_dataFile.isOpen() && m_dataFile.seek(faviconImage.offset))
+	{
+		return m_dataFile.read(faviconImage.size);
+	}
+
+	return QByteArray();
+}
+
+QString FaviconsManager::getPageKey(const QUrl &url)
+{
+	return url.adjusted(QUrl::RemoveFragment | QUrl::RemoveUserInfo).toString();
+}
+
+QIcon FaviconsManager::getIcon(const QUrl &url)
+{
+	if (!m_instance || !m_instance->m_isEnabled || url.isEmpty())
+	{
+		return QIcon();
+	}
+
+	m_instance->load();
+
+	const QString page(getPageKey(url));
+	quint32 identifier(0);
+
+	if (m_instance->m_pages.contains(page))
+	{
+		identifier = m_instance->m_pages[page];
+	}
+	else if (m_instance->m_hosts.contains(url.host()))
+	{
+		identifier = m_instance->m_hosts[url.host()];
+	}
+	else
+	{
+		return QIcon();
+	}
+
+	if (!m_instance->m_icons.contains(identifier))
+	{
+		m_instance->m_icons[identifier] = QIcon(new FaviconIconEngine(identifier, m_instance->m_generation));
+	}
+
+	return m_instance->m_icons[identifier];
+}
+
+QPixmap FaviconsManager::getPixmap(quint32 image, quint32 generation)
+{
+	if (!m_instance || generation != m_instance->m_generation || image >= quint32(m_instance->m_images.count()))
+	{
+		return QPixmap();
+	}
+
+	QPixmap *cachedPixmap(m_instance->m_pixmaps.object(image));
+
+	if (cachedPixmap)
+	{
+		return *cachedPixmap;
+	}
+
+	QPixmap pixmap;
+	pixmap.loadFromData(m_instance->getImageData(image), "PNG");
+
+	m_instance->m_pixmaps.insert(image, new QPixmap(pixmap));
+
+	return pixmap;
+}
+
+}
@@ -0,0 +1,109 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef MEERKAT_FAVICONSMANAGER_H
+#define MEERKAT_FAVICONSMANAGER_H
+
+#include <QtCore/QCache>
+#include <QtCore/QFile>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QUrl>
+#include <QtCore/QVector>
+#include <QtGui/QIcon>
+#include <QtGui/QIconEngine>
+
+namespace Meerkat
+{
+
+class FaviconIconEngine : public QIconEngine
+{
+public:
+	explicit FaviconIconEngine(quint32 image, quint32 generation);
+
+	void paint(QPainter *painter, const QRect &rectangle, QIcon::Mode mode, QIcon::State state);
+	QIconEngine* clone() const;
+	QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state);
+
+private:
+	quint32 m_image;
+	quint32 m_generation;
+};
+
+class FaviconsManager : public QObject
+{
+	Q_OBJECT
+
+public:
+	struct FaviconImage
+	{
+		QByteArray hash;
+		quint64 offset = 0;
+		quint32 size = 0;
+	};
+
+	~FaviconsManager();
+
+	static void createInstance(QObject *parent = nullptr);
+	static void clearIcons();
+	static void removeIcons(const QList<QUrl> &urls, const QSet<QString> &retainedHosts);
+	static void setIcon(const QUrl &url, const QIcon &icon);
+	static FaviconsManager* getInstance();
+	static QIcon getIcon(const QUrl &url);
+	static QPixmap getPixmap(quint32 image, quint32 generation);
+
+protected:
+	explicit FaviconsManager(QObject *parent = nullptr);
+
+	void timerEvent(QTimerEvent *event);
+	void scheduleSave();
+	void save();
+	void load();
+	bool compactData();
+	void mapData();
+	void unmapData();
+	QByteArray getImageData(quint32 image);
+	static QString getPageKey(const QUrl &url);
+
+protected slots:
+	void optionChanged(int identifier, const QVariant &value);
+
+private:
+	QFile m_dataFile;
+	QCache<quint32, QPixmap> m_pixmaps;
+	QHash<quint32, QIcon> m_icons;
+	QHash<QByteArray, quint32> m_hashes;
+	QHash<QString, quint32> m_hosts;
+	QHash<QString, quint32> m_pages;
+	QVector<FaviconImage> m_images;
+	QString m_dataFileName;
+	QByteArray m_pendingData;
+	uchar *m_data;
+	qint64 m_dataSize;
+	quint32 m_generation;
+	int m_saveTimer;
+	bool m_isEnabled;
+	bool m_isLoaded;
+
+	static FaviconsManager *m_instance;
+};
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include "SessionsManager.h"
 #include "Settings.h"
 #include "SettingsManager.h"
+#include "Tracer.h"
 #include "../ui/MainWindow.h"
 
 #include <QtCore/QRegularExpression>
@@ -32,6 +33,7 @@
 
 #define UNKNOWN_GESTURE -1
 #define NATIVE_GESTURE -2
+#define RECORDED_EVENTS_CAPACITY 256
 
 namespace Meerkat
 {
@@ -120,20 +122,28 @@ QPoint GesturesManager::m_lastPosition;
 QVariantMap GesturesManager::m_paramaters;
 QHash<GesturesManager::GesturesContext, QVector<GesturesManager::MouseGesture> > GesturesManager::m_gestures;
 QHash<GesturesManager::GesturesContext, QList<QList<GesturesManager::GestureStep> > > GesturesManager::m_nativeGestures;
-QList<QInputEvent*> GesturesManager::m_events;
+QHash<GesturesManager::GesturesContext, QVector<GesturesManager::GestureNode> > GesturesManager::m_trees;
+QVector<GesturesManager::InputEventData> GesturesManager::m_events;
 QList<GesturesManager::GestureStep> GesturesManager::m_steps;
 QList<GesturesManager::GesturesContext> GesturesManager::m_contexts;
+int GesturesManager::m_eventsAmount(0);
+int GesturesManager::m_lastMoveDistance(0);
 bool GesturesManager::m_isReleasing(false);
+bool GesturesManager::m_isReplaying(false);
 bool GesturesManager::m_afterScroll(false);
 
 GesturesManager::GesturesManager(QObject *parent) : QObject(parent),
 	m_reloadTimer(0)
 {
+	m_events.resize(RECORDED_EVENTS_CAPACITY);
+
 	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int)));
 }
 
 void GesturesManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		QList<QList<GestureStep> > generic;
@@ -292,6 +302,77 @@ void GesturesManager::loadProfiles()
 			profile.endGroup();
 		}
 	}
+
+	compileGestures();
+}
+
+void GesturesManager::compileGestures()
+{
+	m_trees.clear();
+
+	QHash<GesturesContext, QVector<MouseGesture> >::const_iterator iterator;
+
+	for (iterator = m_gestures.constBegin(); iterator != m_gestures.constEnd(); ++iterator)
+	{
+		QVector<GestureNode> tree(1);
+		const QList<QList<GestureStep> > nativeGestures(m_nativeGestures.value(iterator.key()));
+		int order(0);
+
+		for (int i = 0; i < nativeGestures.count(); ++i)
+		{
+			addGesture(&tree, nativeGestures.at(i), NATIVE_GESTURE, order);
+
+			++order;
+		}
+
+		for (int i = 0; i < iterator.value().count(); ++i)
+		{
+			addGesture(&tree, iterator.value().at(i).steps, iterator.value().at(i).action, order);
+
+			++order;
+		}
+
+		m_trees[iterator.key()] = tree;
+	}
+}
+
+void GesturesManager::addGesture(QVector<GestureNode> *tree, const QList<GestureStep> &steps, int action, int order)
+{
+	int node(0);
+
+	for (int i = 0; i < steps.count(); ++i)
+	{
+		int child(-1);
+
+		for (int j = 0; j < tree->at(node).children.count(); ++j)
+		{
+			if (tree->at(tree->at(node).children.at(j)).step == steps.at(i))
+			{
+				child = tree->at(node).children.at(j);
+
+				break;
+			}
+		}
+
+		if (child < 0)
+		{
+			GestureNode stepNode;
+			stepNode.step = steps.at(i);
+
+			child = tree->count();
+
+			tree->append(stepNode);
+			(*tree)[node].children.append(child);
+		}
+
+		node = child;
+	}
+
+	if (node > 0 && tree->at(node).order < 0)
+	{
+		(*tree)[node].action = action;
+		(*tree)[node].order = order;
+	}
 }
 
 void GesturesManager::releaseObject()
@@ -312,13 +393,80 @@ void GesturesManager::endGesture()
 
 	m_steps.clear();
 
-	qDeleteAll(m_events);
+	m_eventsAmount = 0;
+	m_lastMoveDistance = 0;
+}
+
+void GesturesManager::recordEvent(QInputEvent *event)
+{
+	if (m_eventsAmount == m_events.count())
+	{
+		m_events.resize(qMax(RECORDED_EVENTS_CAPACITY, (m_events.count() * 2)));
+	}
+
+	InputEventData &data(m_events[m_eventsAmount]);
+	data.type = event->type();
+	data.modifiers = event->modifiers();
+
+	++m_eventsAmount;
+
+	if (event->type() == QEvent::Wheel)
+	{
+		const QWheelEvent *wheelEvent(static_cast<QWheelEvent*>(event));
+
+		data.localPosition = wheelEvent->posF();
+		data.screenPosition = wheelEvent->globalPosF();
+		data.pixelDelta = wheelEvent->pixelDelta();
+		data.angleDelta = wheelEvent->angleDelta();
+		data.button = Qt::NoButton;
+		data.buttons = wheelEvent->buttons();
+		data.orientation = wheelEvent->orientation();
+		data.delta = wheelEvent->delta();
+	}
+	else
+	{
+		const QMouseEvent *mouseEvent(static_cast<QMouseEvent*>(event));
+
+		data.localPosition = mouseEvent->localPos();
+		data.windowPosition = mouseEvent->windowPos();
+		data.screenPosition = mouseEvent->screenPos();
+		data.button = mouseEvent->button();
+		data.buttons = mouseEvent->buttons();
+	}
+}
+
+void GesturesManager::replayEvents()
+{
+	m_isReplaying = true;
+
+	for (int i = 0; (i < m_eventsAmount && m_trackedObject); ++i)
+	{
+		const InputEventData data(m_events.at(i));
+
+		if (data.type == QEvent::Wheel)
+		{
+			QWheelEvent event(data.localPosition, data.screenPosition, data.pixelDelta, data.angleDelta, data.delta, data.orientation, data.buttons, data.modifiers);
+
+			QCoreApplication::sendEvent(m_trackedObject, &event);
+		}
+		else
+		{
+			QMouseEvent event(data.type, data.localPosition, data.windowPosition, data.screenPosition, data.button, data.buttons, data.modifiers);
+
+			QCoreApplication::sendEvent(m_trackedObject, &event);
+		}
+	}
 
-	m_events.clear();
+	m_isReplaying = false;
 }
 
 GesturesManager* GesturesManager::getInstance()
 {
+	if (!m_instance)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
 	return m_instance;
 }
 
@@ -449,24 +597,34 @@ QList<GesturesManager::GestureStep> GesturesManager::recognizeMoveStep(QInputEve
 
 	for (int i = 0; i < m_contexts.count(); ++i)
 	{
-		for (int j = 0; j < m_gestures[m_contexts[i]].count(); ++j)
+		if (!m_trees.contains(m_contexts.at(i)))
 		{
-			QList<GestureStep> steps(m_gestures[m_contexts[i]][j].steps);
+			continue;
+		}
 
-			if (steps.count() > m_steps.count() && steps[m_steps.count()].type == QEvent::MouseMove && steps.mid(0, m_steps.count()) == m_steps)
-			{
-				MouseGestures::ActionList moves;
+		const QVector<GestureNode> &tree(m_trees[m_contexts.at(i)]);
+		int node(0);
 
-				for (int k = m_steps.count(); k < steps.count() && steps[k].type == QEvent::MouseMove; ++k)
-				{
-					moves.push_back(steps[k].direction);
-				}
+		for (int j = 0; j < m_steps.count() && node >= 0; ++j)
+		{
+			int child(-1);
 
-				if (!moves.empty())
+			for (int k = 0; k < tree.at(node).children.count(); ++k)
+			{
+				if (tree.at(tree.at(node).children.at(k)).step == m_steps.at(j))
 				{
-					possibleMoves.insert(m_recognizer->registerGesture(moves), moves);
+					child = tree.at(node).children.at(k);
+
+					break;
 				}
 			}
+
+			node = child;
+		}
+
+		if (node >= 0)
+		{
+			collectMoves(tree, node, MouseGestures::ActionList(), &possibleMoves);
 		}
 	}
 
@@ -494,140 +652,157 @@ QList<GesturesManager::GestureStep> GesturesManager::recognizeMoveStep(QInputEve
 	return result;
 }
 
+void GesturesManager::collectMoves(const QVector<GestureNode> &tree, int node, const MouseGestures::ActionList &moves, QHash<int, MouseGestures::ActionList> *possibleMoves)
+{
+	for (int i = 0; i < tree.at(node).children.count(); ++i)
+	{
+		const GestureNode &child(tree.at(tree.at(node).children.at(i)));
+
+		if (child.step.type != QEvent::MouseMove)
+		{
+			continue;
+		}
+
+		MouseGestures::ActionList childMoves(moves);
+		childMoves.push_back(child.step.direction);
+
+		bool isRunEnd(child.order >= 0);
+
+		for (int j = 0; j < child.children.count() && !isRunEnd; ++j)
+		{
+			isRunEnd = (tree.at(child.children.at(j)).step.type != QEvent::MouseMove);
+		}
+
+		if (isRunEnd)
+		{
+			possibleMoves->insert(m_recognizer->registerGesture(childMoves), childMoves);
+		}
+
+		collectMoves(tree, tree.at(node).children.at(i), childMoves, possibleMoves);
+	}
+}
+
 int GesturesManager::matchGesture()
 {
-	int bestGesture(0);
+	int bestGesture(UNKNOWN_GESTURE);
 	int lowestDifference(std::numeric_limits<int>::max());
-	int difference(0);
 
 	for (int i = 0; i < m_contexts.count(); ++i)
 	{
-		for (int j = 0; j < m_nativeGestures[m_contexts[i]].count(); ++j)
+		if (!m_trees.contains(m_contexts.at(i)))
 		{
-			difference = gesturesDifference(m_nativeGestures[m_contexts[i]][j]);
+			continue;
+		}
 
-			if (difference == 0)
-			{
-				return NATIVE_GESTURE;
-			}
+		int contextDifference(lowestDifference);
+		int contextOrder(std::numeric_limits<int>::max());
+		int contextGesture(UNKNOWN_GESTURE);
 
-			if (difference < lowestDifference)
-			{
-				bestGesture = NATIVE_GESTURE;
-				lowestDifference = difference;
-			}
-		}
+		matchNode(m_trees[m_contexts.at(i)], 0, 0, 0, &contextDifference, &contextOrder, &contextGesture);
 
-		for (int j = 0; j < m_gestures[m_contexts[i]].count(); ++j)
+		if (contextOrder < std::numeric_limits<int>::max() && contextDifference < lowestDifference)
 		{
-			difference = gesturesDifference(m_gestures[m_contexts[i]][j].steps);
-
-			if (difference == 0)
+			if (contextDifference == 0)
 			{
-				return m_gestures[m_contexts[i]][j].action;
+				return contextGesture;
 			}
 
-			if (difference < lowestDifference)
-			{
-				bestGesture = m_gestures[m_contexts[i]][j].action;
-				lowestDifference = difference;
-			}
+			bestGesture = contextGesture;
+			lowestDifference = contextDifference;
 		}
 	}
 
-	return ((lowestDifference < std::numeric_limits<int>::max()) ? bestGesture : UNKNOWN_GESTURE);
+	return bestGesture;
 }
 
-int GesturesManager::getLastMoveDistance(bool measureFinished)
+void GesturesManager::matchNode(const QVector<GestureNode> &tree, int node, int depth, int difference, int *lowestDifference, int *lowestOrder, int *bestGesture)
 {
-	int result(0);
-	int index(m_events.count() - 1);
-
-	if (!measureFinished && (index < 0 || m_events[index]->type() != QEvent::MouseMove))
+	if (depth == m_steps.count())
 	{
-		return result;
-	}
+		if (tree.at(node).order >= 0 && (difference < *lowestDifference || (difference == *lowestDifference && tree.at(node).order < *lowestOrder)))
+		{
+			*lowestDifference = difference;
+			*lowestOrder = tree.at(node).order;
+			*bestGesture = tree.at(node).action;
+		}
 
-	while (index >= 0 && m_events[index]->type() != QEvent::MouseMove)
-	{
-		--index;
+		return;
 	}
 
-	for (; index > 0 && m_events[index - 1]->type() == QEvent::MouseMove; --index)
+	const bool isLast(depth == (m_steps.count() - 1));
+
+	for (int i = 0; i < tree.at(node).children.count(); ++i)
 	{
-		QMouseEvent *current(static_cast<QMouseEvent*>(m_events[index]));
-		QMouseEvent *previous(static_cast<QMouseEvent*>(m_events[index - 1]));
+		const int child(tree.at(node).children.at(i));
+		const int stepDifference(getStepDifference(tree.at(child).step, m_steps.at(depth), isLast));
 
-		if (current && previous)
+		if (stepDifference >= 0 && (difference + stepDifference) <= *lowestDifference)
 		{
-			result += (previous->pos() - current->pos()).manhattanLength();
-		}
-		else
-		{
-			break;
+			matchNode(tree, child, (depth + 1), (difference + stepDifference), lowestDifference, lowestOrder, bestGesture);
 		}
 	}
+}
 
-	return result;
+GesturesManager::InputEventData* GesturesManager::getLastEvent()
+{
+	return ((m_eventsAmount > 0) ? &m_events[m_eventsAmount - 1] : nullptr);
 }
 
-int GesturesManager::gesturesDifference(QList<GestureStep> defined)
+int GesturesManager::getLastMoveDistance(bool measureFinished)
 {
-	if (m_steps.count() != defined.count())
+	if (!measureFinished && (!getLastEvent() || getLastEvent()->type != QEvent::MouseMove))
 	{
-		return std::numeric_limits<int>::max();
+		return 0;
 	}
 
-	int difference(0);
+	return m_lastMoveDistance;
+}
 
-	for (int j = 0; j < defined.count(); ++j)
+int GesturesManager::getStepDifference(const GestureStep &defined, const GestureStep &step, bool isLast)
+{
+	if (isLast && defined.type == QEvent::MouseButtonPress && step.type == QEvent::MouseButtonDblClick && defined.button == step.button && defined.modifiers == step.modifiers)
 	{
-		int stepDifference(0);
-
-		if (j == (defined.count() - 1) && defined[j].type == QEvent::MouseButtonPress && m_steps[j].type == QEvent::MouseButtonDblClick && defined[j].button == m_steps[j].button && defined[j].modifiers == m_steps[j].modifiers)
-		{
-			stepDifference += 100;
-		}
-
-		if (m_steps[j].type == defined[j].type && (defined[j].type == QEvent::MouseButtonPress || defined[j].type == QEvent::MouseButtonRelease || defined[j].type == QEvent::MouseButtonDblClick) && m_steps[j].button == defined[j].button && (m_steps[j].modifiers | defined[j].modifiers) == m_steps[j].modifiers)
-		{
-			if (m_steps[j].modifiers.testFlag(Qt::ControlModifier) && !defined[j].modifiers.testFlag(Qt::ControlModifier))
-			{
-				stepDifference += 8;
-			}
-
-			if (m_steps[j].modifiers.testFlag(Qt::ShiftModifier) && !defined[j].modifiers.testFlag(Qt::ShiftModifier))
-			{
-				stepDifference += 4;
-			}
-
-			if (m_steps[j].modifiers.testFlag(Qt::AltModifier) && !defined[j].modifiers.testFlag(Qt::AltModifier))
-			{
-				stepDifference += 2;
-			}
+		return 100;
+	}
 
-			if (m_steps[j].modifiers.testFlag(Qt::MetaModifier) && !defined[j].modifiers.testFlag(Qt::MetaModifier))
-			{
-				stepDifference += 1;
-			}
-		}
+	if (step.type == defined.type && (defined.type == QEvent::MouseButtonPress || defined.type == QEvent::MouseButtonRelease || defined.type == QEvent::MouseButtonDblClick) && step.button == defined.button && (step.modifiers | defined.modifiers) == step.modifiers)
+	{
+		const Qt::KeyboardModifiers extraModifiers(step.modifiers & ~defined.modifiers);
+		const int penalty((extraModifiers.testFlag(Qt::ControlModifier) ? 8 : 0) + (extraModifiers.testFlag(Qt::ShiftModifier) ? 4 : 0) + (extraModifiers.testFlag(Qt::AltModifier) ? 2 : 0) + (extraModifiers.testFlag(Qt::MetaModifier) ? 1 : 0));
 
-		if (stepDifference == 0 && defined[j] != m_steps[j])
+		if (penalty > 0)
 		{
-			return std::numeric_limits<int>::max();
+			return penalty;
 		}
-
-		difference += stepDifference;
 	}
 
-	return difference;
+	return ((defined == step) ? 0 : -1);
 }
 
 bool GesturesManager::startGesture(QObject *object, QEvent *event, QList<GesturesContext> contexts, const QVariantMap &parameters)
 {
 	QInputEvent *inputEvent(static_cast<QInputEvent*>(event));
 
-	if (!object || !inputEvent || m_gestures.keys().toSet().intersect(contexts.toSet()).isEmpty() || m_events.contains(inputEvent))
+	getInstance();
+
+	if (!object || !inputEvent || m_isReplaying)
+	{
+		return false;
+	}
+
+	bool hasContext(false);
+
+	for (int i = 0; i < contexts.count(); ++i)
+	{
+		if (m_trees.contains(contexts.at(i)))
+		{
+			hasContext = true;
+
+			break;
+		}
+	}
+
+	if (!hasContext)
 	{
 		return false;
 	}
@@ -641,7 +816,6 @@ bool GesturesManager::startGesture(QObject *object, QEvent *event, QList<Gesture
 		m_afterScroll = false;
 	}
 
-	createInstance();
 	releaseObject();
 
 	m_trackedObject = object;
@@ -667,10 +841,7 @@ bool GesturesManager::triggerAction(int gestureIdentifier)
 
 	if (gestureIdentifier == NATIVE_GESTURE)
 	{
-		for (int i = 0; i < m_events.count(); ++i)
-		{
-			QCoreApplication::sendEvent(m_trackedObject, m_events[i]);
-		}
+		replayEvents();
 
 		m_instance->endGesture();
 	}
@@ -718,17 +889,12 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 		case QEvent::MouseButtonPress:
 		case QEvent::MouseButtonRelease:
 		case QEvent::MouseButtonDblClick:
-			if (mouseEvent && !m_events.isEmpty() && m_events.last()->type() == event->type())
+			if (mouseEvent && getLastEvent() && getLastEvent()->type == event->type() && getLastEvent()->button == mouseEvent->button() && getLastEvent()->modifiers == mouseEvent->modifiers())
 			{
-				QMouseEvent *previousMouseEvent(static_cast<QMouseEvent*>(m_events.last()));
-
-				if (previousMouseEvent && previousMouseEvent->button() == mouseEvent->button() && previousMouseEvent->modifiers() == mouseEvent->modifiers())
-				{
-					break;
-				}
+				break;
 			}
 
-			m_events.append(new QMouseEvent(event->type(), mouseEvent->localPos(), mouseEvent->windowPos(), mouseEvent->screenPos(), mouseEvent->button(), mouseEvent->buttons(), mouseEvent->modifiers()));
+			recordEvent(mouseEvent);
 
 			if (m_afterScroll && event->type() == QEvent::MouseButtonRelease)
 			{
@@ -774,7 +940,16 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 
 			break;
 		case QEvent::MouseMove:
-			m_events.push_back(new QMouseEvent(event->type(), mouseEvent->localPos(), mouseEvent->windowPos(), mouseEvent->screenPos(), mouseEvent->button(), mouseEvent->buttons(), mouseEvent->modifiers()));
+			if (getLastEvent() && getLastEvent()->type == QEvent::MouseMove)
+			{
+				m_lastMoveDistance += (getLastEvent()->localPosition.toPoint() - mouseEvent->pos()).manhattanLength();
+			}
+			else
+			{
+				m_lastMoveDistance = 0;
+			}
+
+			recordEvent(mouseEvent);
 
 			m_afterScroll = false;
 
@@ -808,7 +983,7 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 
 			break;
 		case QEvent::Wheel:
-			m_events.push_back(new QWheelEvent(wheelEvent->pos(), wheelEvent->globalPos(), wheelEvent->pixelDelta(), wheelEvent->angleDelta(), wheelEvent->delta(), wheelEvent->orientation(), wheelEvent->buttons(), wheelEvent->modifiers()));
+			recordEvent(wheelEvent);
 			m_steps.append(recognizeMoveStep(wheelEvent));
 			m_steps.append(GestureStep(wheelEvent));
 
@@ -830,9 +1005,9 @@ bool GesturesManager::eventFilter(QObject *object, QEvent *event)
 				m_steps.removeAt(m_steps.count() - 1);
 			}
 
-			while (!m_events.isEmpty() && m_events[m_events.count() - 1]->type() == QEvent::Wheel)
+			while (getLastEvent() && getLastEvent()->type == QEvent::Wheel)
 			{
-				m_events.removeAt(m_events.count() - 1);
+				--m_eventsAmount;
 			}
 
 			m_afterScroll = true;
@@ -77,15 +77,45 @@ protected:
 		int action = 0;
 	};
 
+	struct GestureNode
+	{
+		GestureStep step;
+		QVector<int> children;
+		int action = 0;
+		int order = -1;
+	};
+
+	struct InputEventData
+	{
+		QPointF localPosition;
+		QPointF windowPosition;
+		QPointF screenPosition;
+		QPoint pixelDelta;
+		QPoint angleDelta;
+		QEvent::Type type = QEvent::None;
+		Qt::MouseButton button = Qt::NoButton;
+		Qt::MouseButtons buttons = Qt::NoButton;
+		Qt::KeyboardModifiers modifiers = Qt::NoModifier;
+		Qt::Orientation orientation = Qt::Vertical;
+		int delta = 0;
+	};
+
 	explicit GesturesManager(QObject *parent);
 
 	void timerEvent(QTimerEvent *event);
 	static void releaseObject();
+	static void recordEvent(QInputEvent *event);
+	static void replayEvents();
+	static void compileGestures();
+	static void addGesture(QVector<GestureNode> *tree, const QList<GestureStep> &steps, int action, int order);
+	static void collectMoves(const QVector<GestureNode> &tree, int node, const MouseGestures::ActionList &moves, QHash<int, MouseGestures::ActionList> *possibleMoves);
+	static void matchNode(const QVector<GestureNode> &tree, int node, int depth, int difference, int *lowestDifference, int *lowestOrder, int *bestGesture);
 	static GestureStep deserializeStep(const QString &string);
 	static QList<GestureStep> recognizeMoveStep(QInputEvent *event);
 	static int matchGesture();
+	static InputEventData* getLastEvent();
 	static int getLastMoveDistance(bool measureFinished = false);
-	static int gesturesDifference(QList<GestureStep> defined);
+	static int getStepDifference(const GestureStep &defined, const GestureStep &step, bool isLast);
 	static bool triggerAction(int gestureIdentifier);
 	bool eventFilter(QObject *object, QEvent *event);
 
@@ -104,10 +134,14 @@ private:
 	static QVariantMap m_paramaters;
 	static QHash<GesturesContext, QVector<MouseGesture> > m_gestures;
 	static QHash<GesturesContext, QList<QList<GestureStep> > > m_nativeGestures;
+	static QHash<GesturesContext, QVector<GestureNode> > m_trees;
 	static QList<GestureStep> m_steps;
-	static QList<QInputEvent*> m_events;
+	static QVector<InputEventData> m_events;
 	static QList<GesturesContext> m_contexts;
+	static int m_eventsAmount;
+	static int m_lastMoveDistance;
 	static bool m_isReleasing;
+	static bool m_isReplaying;
 	static bool m_afterScroll;
 };
 
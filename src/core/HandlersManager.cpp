@@ -21,7 +21,9 @@
 #include "SessionsManager.h"
 #include "Settings.h"
 #include "SettingsManager.h"
+#include "Tracer.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
 
 namespace Meerkat
@@ -35,6 +37,8 @@ HandlersManager::HandlersManager(QObject *parent) : QObject(parent)
 
 void HandlersManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new HandlersManager(parent);
@@ -43,6 +47,11 @@ void HandlersManager::createInstance(QObject *parent)
 
 HandlersManager* HandlersManager::getInstance()
 {
+	if (!m_instance)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
 	return m_instance;
 }
 
@@ -18,9 +18,11 @@
 **************************************************************************/
 
 #include "HistoryManager.h"
+#include "FaviconsManager.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "ThemesManager.h"
+#include "Tracer.h"
 
 #include <QtCore/QBuffer>
 #include <QtCore/QFile>
@@ -49,6 +51,8 @@ HistoryManager::HistoryManager(QObject *parent) : QObject(parent),
 
 void HistoryManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new HistoryManager(parent);
@@ -170,9 +174,31 @@ void HistoryManager::clearHistory(uint period)
 		getTypedHistoryModel();
 	}
 
+	const QSet<QUrl> previousUrls((period == 0) ? QSet<QUrl>() : m_browsingHistoryModel->getUrls().toSet());
+
 	m_browsingHistoryModel->clearRecentEntries(period);
 	m_typedHistoryModel->clearRecentEntries(period);
 
+	if (period == 0)
+	{
+		FaviconsManager::clearIcons();
+	}
+	else
+	{
+		const QList<QUrl> urls(m_browsingHistoryModel->getUrls());
+		QSet<QUrl> removedUrls(previousUrls);
+		QSet<QString> hosts;
+
+		for (int i = 0; i < urls.count(); ++i)
+		{
+			removedUrls.remove(urls.at(i));
+
+			hosts.insert(urls.at(i).host());
+		}
+
+		FaviconsManager::removeIcons(removedUrls.toList(), hosts);
+	}
+
 	m_instance->scheduleSave();
 }
 
@@ -205,11 +231,15 @@ void HistoryManager::removeEntries(const QList<quint64> &identifiers)
 		getBrowsingHistoryModel();
 	}
 
+	m_browsingHistoryModel->beginChanges();
+
 	for (int i = 0; i < identifiers.count(); ++i)
 	{
 		m_browsingHistoryModel->removeEntry(identifiers.at(i));
 	}
 
+	m_browsingHistoryModel->endChanges();
+
 	m_instance->scheduleSave();
 }
 
@@ -238,7 +268,12 @@ void HistoryManager::updateEntry(quint64 identifier, const QUrl &url, const QStr
 	{
 		item->setData(url, HistoryModel::UrlRole);
 		item->setData(title, HistoryModel::TitleRole);
-		item->setIcon(icon);
+		item->setIcon(icon.isNull() ? FaviconsManager::getIcon(url) : icon);
+	}
+
+	if (m_isStoringFavicons)
+	{
+		FaviconsManager::setIcon(url, icon);
 	}
 
 	m_instance->scheduleSave();
@@ -311,9 +346,9 @@ QIcon HistoryManager::getIcon(const QUrl &url)
 		return ThemesManager::getIcon(QLatin1String("text-html"));
 	}
 
-///TODO
+	const QIcon icon(FaviconsManager::getIcon(url));
 
-	return ThemesManager::getIcon(QLatin1String("text-html"));
+	return (icon.isNull() ? ThemesManager::getIcon(QLatin1String("text-html")) : icon);
 }
 
 HistoryEntryItem* HistoryManager::getEntry(quint64 identifier)
@@ -359,6 +394,11 @@ quint64 HistoryManager::addEntry(const QUrl &url, const QString &title, const QI
 
 	const quint64 identifier(m_browsingHistoryModel->addEntry(url, title, icon, QDateTime::currentDateTime())->data(HistoryModel::IdentifierRole).toULongLong());
 
+	if (m_isStoringFavicons)
+	{
+		FaviconsManager::setIcon(url, icon);
+	}
+
 	if (isTypedIn)
 	{
 		if (!m_typedHistoryModel)
@@ -399,4 +439,9 @@ bool HistoryManager::hasEntry(const QUrl &url)
 	return m_browsingHistoryModel->hasEntry(url);
 }
 
+bool HistoryManager::isEnabled()
+{
+	return m_isEnabled;
+}
+
 }
@@ -19,7 +19,9 @@
 
 #include "HistoryModel.h"
 #include "Console.h"
+#include "FaviconsManager.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
 #include "Utils.h"
 
 #include <QtCore/QFile>
@@ -52,8 +54,23 @@ void HistoryEntryItem::setItemData(const QVariant &value, int role)
 	QStandardItem::setData(value, role);
 }
 
-HistoryModel::HistoryModel(const QString &path, QObject *parent) : QStandardItemModel(parent)
+QVariant HistoryEntryItem::data(int role) const
 {
+	if (role == Qt::DecorationRole)
+	{
+		const QVariant icon(QStandardItem::data(role));
+
+		return (icon.isNull() ? FaviconsManager::getIcon(QStandardItem::data(HistoryModel::UrlRole).toUrl()) : icon);
+	}
+
+	return QStandardItem::data(role);
+}
+
+HistoryModel::HistoryModel(const QString &path, QObject *parent) : QStandardItemModel(parent),
+	m_changesDepth(0)
+{
+	MEERKAT_TRACE_FUNCTION("history");
+
 	QFile file(path);
 
 	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
@@ -67,6 +84,8 @@ HistoryModel::HistoryModel(const QString &path, QObject *parent) : QStandardItem
 
 	file.close();
 
+	beginChanges();
+
 	for (int i = 0; i < array.count(); ++i)
 	{
 		const QJsonObject object(array.at(i).toObject());
@@ -74,18 +93,103 @@ HistoryModel::HistoryModel(const QString &path, QObject *parent) : QStandardItem
 		addEntry(QUrl(object.value(QLatin1String("url")).toString()), object.value(QLatin1String("title")).toString(), QIcon(), QDateTime::fromString(object.value(QLatin1String("time")).toString(), QLatin1String("yyyy-MM-dd hh:mm:ss")));
 	}
 
+	endChanges();
+
 	setSortRole(TimeVisitedRole);
 	sort(0, Qt::DescendingOrder);
 }
 
+void HistoryModel::beginChanges()
+{
+	++m_changesDepth;
+}
+
+void HistoryModel::endChanges()
+{
+	if (m_changesDepth == 0)
+	{
+		return;
+	}
+
+	--m_changesDepth;
+
+	if (m_changesDepth > 0)
+	{
+		return;
+	}
+
+	const bool hasChanges(!m_removedEntries.isEmpty() || !m_pendingEntries.isEmpty());
+
+	if (!m_removedEntries.isEmpty())
+	{
+		QList<int> rows;
+		rows.reserve(m_removedEntries.count());
+
+		for (int i = 0; i < m_removedEntries.count(); ++i)
+		{
+			rows.append(m_removedEntries.at(i)->row());
+		}
+
+		m_removedEntries.clear();
+
+		qSort(rows.begin(), rows.end(), qGreater<int>());
+
+		int i(0);
+
+		while (i < rows.count())
+		{
+			int amount(1);
+
+			while ((i + amount) < rows.count() && rows.at(i + amount) == (rows.at(i) - amount))
+			{
+				++amount;
+			}
+
+			removeRows((rows.at(i) - amount + 1), amount);
+
+			i += amount;
+		}
+	}
+
+	if (!m_pendingEntries.isEmpty())
+	{
+		const QList<HistoryEntryItem*> entries(m_pendingEntries);
+		QList<QStandardItem*> items;
+		items.reserve(entries.count());
+
+		m_pendingEntries.clear();
+
+		for (int i = (entries.count() - 1); i >= 0; --i)
+		{
+			items.append(entries.at(i));
+		}
+
+		invisibleRootItem()->insertRows(0, items);
+
+		for (int i = 0; i < entries.count(); ++i)
+		{
+			emit entryAdded(entries.at(i));
+		}
+	}
+
+	if (hasChanges)
+	{
+		emit modelModified();
+	}
+}
+
 void HistoryModel::clearExcessEntries(int limit)
 {
 	if (limit > 0 && rowCount() > limit)
 	{
+		beginChanges();
+
 		for (int i = (rowCount() - 1); i >= limit; --i)
 		{
 			removeEntry(index(i, 0).data(HistoryModel::IdentifierRole).toULongLong());
 		}
+
+		endChanges();
 	}
 }
 
@@ -100,13 +204,19 @@ void HistoryModel::clearRecentEntries(uint period)
 		return;
 	}
 
+	const QDateTime currentDateTime(QDateTime::currentDateTime());
+
+	beginChanges();
+
 	for (int i = (rowCount() - 1); i >= 0; --i)
 	{
-		if (index(i, 0).data(TimeVisitedRole).toDateTime().secsTo(QDateTime::currentDateTime()) < (period * 3600))
+		if (index(i, 0).data(TimeVisitedRole).toDateTime().secsTo(currentDateTime) < (period * 3600))
 		{
 			removeEntry(index(i, 0).data(IdentifierRole).toULongLong());
 		}
 	}
+
+	endChanges();
 }
 
 void HistoryModel::clearOldestEntries(int period)
@@ -118,6 +228,8 @@ void HistoryModel::clearOldestEntries(int period)
 
 	const QDateTime currentDateTime(QDateTime::currentDateTime());
 
+	beginChanges();
+
 	for (int i = (rowCount() - 1); i >= 0; --i)
 	{
 		if (index(i, 0).data(TimeVisitedRole).toDateTime().daysTo(currentDateTime) > period)
@@ -125,6 +237,8 @@ void HistoryModel::clearOldestEntries(int period)
 			removeEntry(index(i, 0).data(IdentifierRole).toULongLong());
 		}
 	}
+
+	endChanges();
 }
 
 void HistoryModel::removeEntry(quint64 identifier)
@@ -155,33 +269,60 @@ void HistoryModel::removeEntry(quint64 identifier)
 
 	emit entryRemoved(entry);
 
-	removeRow(entry->row());
+	if (m_pendingEntries.contains(entry))
+	{
+		m_pendingEntries.removeAll(entry);
+
+		delete entry;
+	}
+	else if (m_changesDepth > 0)
+	{
+		m_removedEntries.append(entry);
+	}
+	else
+	{
+		removeRow(entry->row());
 
-	emit modelModified();
+		emit modelModified();
+	}
 }
 
 HistoryEntryItem* HistoryModel::addEntry(const QUrl &url, const QString &title, const QIcon &icon, const QDateTime &date, quint64 identifier)
 {
-	blockSignals(true);
-
 	HistoryEntryItem *entry(new HistoryEntryItem());
-	entry->setIcon(icon);
+	entry->setItemData(url, UrlRole);
+	entry->setItemData(title, TitleRole);
+	entry->setItemData(date, TimeVisitedRole);
 
-	insertRow(0, entry);
-	setData(entry->index(), url, UrlRole);
-	setData(entry->index(), title, TitleRole);
-	setData(entry->index(), date, TimeVisitedRole);
+	if (!icon.isNull())
+	{
+		entry->setItemData(icon, Qt::DecorationRole);
+	}
 
 	if (identifier == 0 || m_identifiers.contains(identifier))
 	{
-		identifier = (m_identifiers.isEmpty() ? 1 : (m_identifiers.keys().last() + 1));
+		identifier = (m_identifiers.isEmpty() ? 1 : (m_identifiers.lastKey() + 1));
 	}
 
-	setData(entry->index(), identifier, IdentifierRole);
+	entry->setItemData(identifier, IdentifierRole);
 
 	m_identifiers[identifier] = entry;
 
-	blockSignals(false);
+	const QUrl normalizedUrl(Utils::normalizeUrl(url));
+
+	if (!normalizedUrl.isEmpty())
+	{
+		m_urls[normalizedUrl].append(entry);
+	}
+
+	if (m_changesDepth > 0)
+	{
+		m_pendingEntries.append(entry);
+
+		return entry;
+	}
+
+	insertRow(0, entry);
 
 	emit entryAdded(entry);
 
@@ -244,8 +385,15 @@ QList<HistoryModel::HistoryEntryMatch> HistoryModel::findEntries(const QString &
 	return allMatches;
 }
 
+QList<QUrl> HistoryModel::getUrls() const
+{
+	return m_urls.keys();
+}
+
 bool HistoryModel::save(const QString &path) const
 {
+	MEERKAT_TRACE_FUNCTION("history");
+
 	if (SessionsManager::isReadOnly())
 	{
 		return false;
@@ -292,7 +440,9 @@ bool HistoryModel::setData(const QModelIndex &index, const QVariant &value, int
 		return QStandardItemModel::setData(index, value, role);
 	}
 
-	if (role == UrlRole && value.toUrl() != index.data(UrlRole).toUrl())
+	const QUrl previousUrl((role == UrlRole) ? index.data(UrlRole).toUrl() : QUrl());
+
+	if (role == UrlRole && value.toUrl() != previousUrl)
 	{
 		const QUrl oldUrl(Utils::normalizeUrl(index.data(UrlRole).toUrl()));
 		const QUrl newUrl(Utils::normalizeUrl(value.toUrl()));
@@ -320,6 +470,11 @@ bool HistoryModel::setData(const QModelIndex &index, const QVariant &value, int
 
 	entry->setItemData(value, role);
 
+	if (role == UrlRole && value.toUrl() != previousUrl)
+	{
+		emit entryUrlChanged(entry, previousUrl);
+	}
+
 	switch (role)
 	{
 		case TitleRole:
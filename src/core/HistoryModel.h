@@ -32,6 +32,7 @@ class HistoryEntryItem : public QStandardItem
 public:
 	void setData(const QVariant &value, int role);
 	void setItemData(const QVariant &value, int role);
+	QVariant data(int role) const;
 
 protected:
 	explicit HistoryEntryItem();
@@ -61,6 +62,8 @@ public:
 
 	explicit HistoryModel(const QString &path, QObject *parent = nullptr);
 
+	void beginChanges();
+	void endChanges();
 	void clearExcessEntries(int limit);
 	void clearRecentEntries(uint period);
 	void clearOldestEntries(int period);
@@ -68,6 +71,7 @@ public:
 	HistoryEntryItem* addEntry(const QUrl &url, const QString &title, const QIcon &icon, const QDateTime &date = QDateTime::currentDateTime(), quint64 identifier = 0);
 	HistoryEntryItem* getEntry(quint64 identifier) const;
 	QList<HistoryEntryMatch> findEntries(const QString &prefix, bool markAsTypedIn = false) const;
+	QList<QUrl> getUrls() const;
 	bool hasEntry(const QUrl &url) const;
 	bool save(const QString &path) const;
 	bool setData(const QModelIndex &index, const QVariant &value, int role);
@@ -75,11 +79,15 @@ public:
 private:
 	QHash<QUrl, QList<HistoryEntryItem*> > m_urls;
 	QMap<quint64, HistoryEntryItem*> m_identifiers;
+	QList<HistoryEntryItem*> m_pendingEntries;
+	QList<HistoryEntryItem*> m_removedEntries;
+	int m_changesDepth;
 
 signals:
 	void cleared();
 	void entryAdded(HistoryEntryItem *entry);
 	void entryModified(HistoryEntryItem *entry);
+	void entryUrlChanged(HistoryEntryItem *entry, const QUrl &previousUrl);
 	void entryRemoved(HistoryEntryItem *entry);
 	void modelModified();
 };
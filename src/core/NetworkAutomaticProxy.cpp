@@ -23,7 +23,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDate>
-#include <QtNetwork/QHostInfo>
+#include <QtCore/QElapsedTimer>
 #include <QtNetwork/QNetworkInterface>
 
 namespace Meerkat
@@ -31,6 +31,8 @@ namespace Meerkat
 
 QStringList PacUtils::m_months = QStringList({QLatin1String("jan"), QLatin1String("feb"), QLatin1String("mar"), QLatin1String("apr"), QLatin1String("may"), QLatin1String("jun"), QLatin1String("jul"), QLatin1String("aug"), QLatin1String("sep"), QLatin1String("oct"), QLatin1String("nov"), QLatin1String("dec")});
 QStringList PacUtils::m_days = QStringList({QLatin1String("mon"), QLatin1String("tue"), QLatin1String("wed"), QLatin1String("thu"), QLatin1String("fri"), QLatin1String("sat"), QLatin1String("sun")});
+QHash<QString, QPair<QHostInfo, qint64> > PacUtils::m_hosts;
+QMutex PacUtils::m_hostsMutex;
 
 PacUtils::PacUtils(QObject *parent) : QObject(parent)
 {
@@ -41,9 +43,21 @@ void PacUtils::alert(const QString &message) const
 	Console::addMessage(message, Console::NetworkCategory, Console::WarningLevel);
 }
 
+void PacUtils::addHostInformation(const QHostInfo &information)
+{
+	if (information.hostName().isEmpty())
+	{
+		return;
+	}
+
+	QMutexLocker locker(&m_hostsMutex);
+
+	m_hosts[information.hostName().toLower()] = qMakePair(information, (QDateTime::currentMSecsSinceEpoch() + 60000));
+}
+
 QString PacUtils::dnsResolve(const QString &host) const
 {
-	const QHostInfo hostInformation(QHostInfo::fromName(host));
+	const QHostInfo hostInformation(getHostInformation(host));
 
 	if (hostInformation.error() == QHostInfo::NoError && !hostInformation.addresses().isEmpty())
 	{
@@ -94,7 +108,32 @@ bool PacUtils::isPlainHostName(const QString &host) const
 
 bool PacUtils::isResolvable(const QString &host) const
 {
-	return (QHostInfo::fromName(host).error() == QHostInfo::NoError);
+	return (getHostInformation(host).error() == QHostInfo::NoError);
+}
+
+QHostInfo PacUtils::getHostInformation(const QString &host)
+{
+	const QString key(host.toLower());
+
+	m_hostsMutex.lock();
+
+	if (m_hosts.contains(key) && m_hosts[key].second > QDateTime::currentMSecsSinceEpoch())
+	{
+		const QHostInfo information(m_hosts[key].first);
+
+		m_hostsMutex.unlock();
+
+		return information;
+	}
+
+	m_hostsMutex.unlock();
+
+	QHostInfo information(QHostInfo::fromName(host));
+	information.setHostName(key);
+
+	addHostInformation(information);
+
+	return information;
 }
 
 bool PacUtils::localHostOrDomainIs(const QString &host, QString domain) const
@@ -286,32 +325,134 @@ bool PacUtils::isInRange(const QVariant &valueOne, const QVariant &valueTwo, con
 	return (actualValue >= valueOne && actualValue <= valueTwo);
 }
 
-NetworkAutomaticProxy::NetworkAutomaticProxy(QObject *parent) : QObject(parent)
+bool PacUtils::hasHostInformation(const QString &host)
+{
+	const QString key(host.toLower());
+	QMutexLocker locker(&m_hostsMutex);
+
+	return (m_hosts.contains(key) && m_hosts[key].second > QDateTime::currentMSecsSinceEpoch());
+}
+
+NetworkAutomaticProxy::NetworkAutomaticProxy(QObject *parent) : QThread(parent),
+	m_isScriptPending(false),
+	m_isValid(false),
+	m_isStopping(false)
 {
-	m_engine.globalObject().setProperty(QLatin1String("PacUtils"), m_engine.newQObject(new PacUtils(this)));
+	m_proxies.insert(QLatin1String("ERROR"), QList<QNetworkProxy>({QNetworkProxy(QNetworkProxy::DefaultProxy)}));
+	m_proxies.insert(QLatin1String("DIRECT"), QList<QNetworkProxy>({QNetworkProxy(QNetworkProxy::NoProxy)}));
+
+	start();
+}
+
+NetworkAutomaticProxy::~NetworkAutomaticProxy()
+{
+	m_mutex.lock();
+
+	m_isStopping = true;
+
+	m_requestCondition.wakeAll();
+	m_resultCondition.wakeAll();
+	m_mutex.unlock();
+
+	wait();
+}
+
+void NetworkAutomaticProxy::run()
+{
+	QJSEngine engine;
+	engine.globalObject().setProperty(QLatin1String("PacUtils"), engine.newQObject(new PacUtils(&engine)));
 
 	const QStringList functions({QLatin1String("alert"), QLatin1String("dnsResolve"), QLatin1String("myIpAddress"), QLatin1String("dnsDomainLevels"), QLatin1String("isInNet"), QLatin1String("isPlainHostName"), QLatin1String("isResolvable"), QLatin1String("localHostOrDomainIs"), QLatin1String("dnsDomainIs"), QLatin1String("shExpMatch"), QLatin1String("weekdayRange"), QLatin1String("dateRange"), QLatin1String("timeRange")});
 
 	for (int i = 0; i < functions.count(); ++i)
 	{
-		m_engine.evaluate(QStringLiteral("function %1() { return PacUtils.%1.apply(null, arguments); }").arg(functions.at(i))).isError();
+		engine.evaluate(QStringLiteral("function %1() { return PacUtils.%1.apply(null, arguments); }").arg(functions.at(i))).isError();
 	}
 
-	m_proxies.insert(QLatin1String("ERROR"), QList<QNetworkProxy>({QNetworkProxy(QNetworkProxy::DefaultProxy)}));
-	m_proxies.insert(QLatin1String("DIRECT"), QList<QNetworkProxy>({QNetworkProxy(QNetworkProxy::NoProxy)}));
+	QJSValue findProxy;
+
+	forever
+	{
+		QMutexLocker locker(&m_mutex);
+
+		while (!m_isStopping && !m_isScriptPending && m_requests.isEmpty())
+		{
+			m_requestCondition.wait(&m_mutex);
+		}
+
+		if (m_isStopping)
+		{
+			return;
+		}
+
+		if (m_isScriptPending)
+		{
+			const QString script(m_script);
+
+			locker.unlock();
+
+			bool isValid(false);
+
+			if (!engine.evaluate(script).isError())
+			{
+				findProxy = engine.globalObject().property(QLatin1String("FindProxyForURL"));
+
+				isValid = findProxy.isCallable();
+			}
+
+			locker.relock();
+
+			m_isValid = isValid;
+			m_isScriptPending = false;
+			m_cache.clear();
+
+			m_resultCondition.wakeAll();
+
+			continue;
+		}
+
+		const QSharedPointer<ProxyRequest> request(m_requests.dequeue());
+
+		locker.unlock();
+
+		const QJSValue result(findProxy.call(QJSValueList({engine.toScriptValue(request->url), engine.toScriptValue(request->host)})));
+		const QList<QNetworkProxy> proxies(result.isError() ? m_proxies[QLatin1String("ERROR")] : parseConfiguration(result.toString().remove(QLatin1Char(' '))));
+
+		locker.relock();
+
+		request->proxies = proxies;
+		request->isFinished = true;
+
+		if (!result.isError())
+		{
+			ProxyEntry entry;
+			entry.proxies = proxies;
+			entry.expiration = (QDateTime::currentMSecsSinceEpoch() + 300000);
+
+			m_cache[request->key] = entry;
+		}
+
+		m_pendingRequests.remove(request->key);
+
+		m_resultCondition.wakeAll();
+	}
 }
 
-QList<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const QString &host)
+void NetworkAutomaticProxy::prefetchHost(const QString &host)
 {
-	const QJSValue result(m_findProxy.call(QJSValueList({m_engine.toScriptValue(url), m_engine.toScriptValue(host)})));
-
-	if (result.isError())
+	if (!host.isEmpty() && !PacUtils::hasHostInformation(host))
 	{
-		return m_proxies[QLatin1String("ERROR")];
+		QHostInfo::lookupHost(host, this, SLOT(handleHostLookup(QHostInfo)));
 	}
+}
 
-	const QString configuration(result.toString().remove(QLatin1Char(' ')));
+void NetworkAutomaticProxy::handleHostLookup(const QHostInfo &information)
+{
+	PacUtils::addHostInformation(information);
+}
 
+QList<QNetworkProxy> NetworkAutomaticProxy::parseConfiguration(const QString &configuration)
+{
 	if (!m_proxies.value(configuration).isEmpty())
 	{
 		return m_proxies[configuration];
@@ -358,16 +499,79 @@ QList<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const Q
 	return m_proxies[configuration];
 }
 
-bool NetworkAutomaticProxy::setup(const QString &script)
+QList<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QUrl &url, const QString &host)
 {
-	if (m_engine.evaluate(script).isError())
+	const QString key(url.scheme() + QLatin1Char('|') + host.toLower());
+	QMutexLocker locker(&m_mutex);
+
+	if (!m_isValid)
+	{
+		return QList<QNetworkProxy>({QNetworkProxy(QNetworkProxy::DefaultProxy)});
+	}
+
+	if (m_cache.contains(key) && m_cache[key].expiration > QDateTime::currentMSecsSinceEpoch())
+	{
+		return m_cache[key].proxies;
+	}
+
+	QSharedPointer<ProxyRequest> request(m_pendingRequests.value(key));
+
+	if (!request)
+	{
+		request = QSharedPointer<ProxyRequest>(new ProxyRequest());
+		request->url = url.toString();
+		request->host = host;
+		request->key = key;
+
+		m_requests.enqueue(request);
+		m_pendingRequests[key] = request;
+
+		m_requestCondition.wakeOne();
+
+		QMetaObject::invokeMethod(this, "prefetchHost", Qt::QueuedConnection, Q_ARG(QString, host));
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	while (!request->isFinished && !m_isStopping)
+	{
+		const qint64 remainingTime(500 - timer.elapsed());
+
+		if (remainingTime <= 0 || !m_resultCondition.wait(&m_mutex, static_cast<unsigned long>(remainingTime)))
+		{
+			break;
+		}
+	}
+
+	if (request->isFinished)
 	{
-		return false;
+		return request->proxies;
 	}
 
-	m_findProxy = m_engine.globalObject().property(QLatin1String("FindProxyForURL"));
+	if (m_cache.contains(key))
+	{
+		return m_cache[key].proxies;
+	}
+
+	return QList<QNetworkProxy>({QNetworkProxy(QNetworkProxy::NoProxy)});
+}
+
+bool NetworkAutomaticProxy::setup(const QString &script)
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_script = script;
+	m_isScriptPending = true;
+
+	m_requestCondition.wakeOne();
+
+	while (m_isScriptPending && !m_isStopping)
+	{
+		m_resultCondition.wait(&m_mutex);
+	}
 
-	return m_findProxy.isCallable();
+	return m_isValid;
 }
 
 }
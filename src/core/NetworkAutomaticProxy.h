@@ -21,6 +21,12 @@
 #ifndef MEERKAT_NETWORKAUTOMATICPROXY_H
 #define MEERKAT_NETWORKAUTOMATICPROXY_H
 
+#include <QtCore/QMutex>
+#include <QtCore/QQueue>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
+#include <QtCore/QWaitCondition>
+#include <QtNetwork/QHostInfo>
 #include <QtNetwork/QNetworkProxy>
 #include <QtQml/QJSEngine>
 
@@ -34,6 +40,10 @@ class PacUtils : public QObject
 public:
 	explicit PacUtils(QObject *parent = nullptr);
 
+	static void addHostInformation(const QHostInfo &information);
+	static QHostInfo getHostInformation(const QString &host);
+	static bool hasHostInformation(const QString &host);
+
 public slots:
 	void alert(const QString &message) const;
 	QString dnsResolve(const QString &host) const;
@@ -55,22 +65,56 @@ protected:
 private:
 	static QStringList m_months;
 	static QStringList m_days;
+	static QHash<QString, QPair<QHostInfo, qint64> > m_hosts;
+	static QMutex m_hostsMutex;
 };
 
-class NetworkAutomaticProxy : public QObject
+class NetworkAutomaticProxy : public QThread
 {
 	Q_OBJECT
 
 public:
 	explicit NetworkAutomaticProxy(QObject *parent = nullptr);
+	~NetworkAutomaticProxy();
 
-	QList<QNetworkProxy> getProxy(const QString &url, const QString &host);
+	QList<QNetworkProxy> getProxy(const QUrl &url, const QString &host);
 	bool setup(const QString &script);
 
+protected:
+	struct ProxyRequest
+	{
+		QString url;
+		QString host;
+		QString key;
+		QList<QNetworkProxy> proxies;
+		bool isFinished = false;
+	};
+
+	struct ProxyEntry
+	{
+		QList<QNetworkProxy> proxies;
+		qint64 expiration = 0;
+	};
+
+	void run();
+	QList<QNetworkProxy> parseConfiguration(const QString &configuration);
+
+protected slots:
+	void prefetchHost(const QString &host);
+	void handleHostLookup(const QHostInfo &information);
+
 private:
-	QJSEngine m_engine;
-	QJSValue m_findProxy;
+	QMutex m_mutex;
+	QWaitCondition m_requestCondition;
+	QWaitCondition m_resultCondition;
+	QString m_script;
+	QQueue<QSharedPointer<ProxyRequest> > m_requests;
+	QHash<QString, QSharedPointer<ProxyRequest> > m_pendingRequests;
+	QHash<QString, ProxyEntry> m_cache;
 	QHash<QString, QList<QNetworkProxy> > m_proxies;
+	bool m_isScriptPending;
+	bool m_isValid;
+	bool m_isStopping;
 };
 
 }
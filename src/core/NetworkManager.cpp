@@ -23,6 +23,7 @@
 #include "LocalListingNetworkReply.h"
 #include "NetworkCache.h"
 #include "NetworkManagerFactory.h"
+#include "NetworkTransport.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "Utils.h"
@@ -37,7 +38,8 @@ namespace Meerkat
 {
 
 NetworkManager::NetworkManager(bool isPrivate, QObject *parent) : QNetworkAccessManager(parent),
-	m_cookieJar(nullptr)
+	m_cookieJar(nullptr),
+	m_isPrivate(isPrivate)
 {
 	NetworkManagerFactory::initialize();
 
@@ -174,6 +176,11 @@ QNetworkReply* NetworkManager::createRequest(QNetworkAccessManager::Operation op
 
 	mutableRequest.setRawHeader(QStringLiteral("Accept-Language").toLatin1(), NetworkManagerFactory::getAcceptLanguage().toLatin1());
 
+	if (request.url().scheme() == QLatin1String("http") || request.url().scheme() == QLatin1String("https"))
+	{
+		return NetworkManagerFactory::getTransport(m_isPrivate)->createReply(this, m_cookieJar, operation, mutableRequest, outgoingData);
+	}
+
 	return QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
 }
 
@@ -75,6 +75,7 @@ protected slots:
 
 private:
 	CookieJar *m_cookieJar;
+	bool m_isPrivate;
 };
 
 }
@@ -25,8 +25,10 @@
 #include "NetworkCache.h"
 #include "NetworkManager.h"
 #include "NetworkProxyFactory.h"
+#include "NetworkTransport.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
+#include "Tracer.h"
 #include "WebBackend.h"
 
 #include <QtCore/QCoreApplication>
@@ -42,6 +44,8 @@ namespace Meerkat
 
 NetworkManagerFactory* NetworkManagerFactory::m_instance(nullptr);
 NetworkManager* NetworkManagerFactory::m_networkManager(nullptr);
+NetworkTransport* NetworkManagerFactory::m_transport(nullptr);
+QPointer<NetworkTransport> NetworkManagerFactory::m_privateTransport(nullptr);
 NetworkCache* NetworkManagerFactory::m_cache(nullptr);
 CookieJar* NetworkManagerFactory::m_cookieJar(nullptr);
 QString NetworkManagerFactory::m_acceptLanguage;
@@ -69,6 +73,8 @@ NetworkManagerFactory::NetworkManagerFactory(QObject *parent) : QObject(parent)
 
 void NetworkManagerFactory::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		QNetworkProxyFactory::setApplicationProxyFactory(new NetworkProxyFactory());
@@ -253,6 +259,26 @@ NetworkManager* NetworkManagerFactory::getNetworkManager()
 	return m_networkManager;
 }
 
+NetworkTransport* NetworkManagerFactory::getTransport(bool isPrivate)
+{
+	if (isPrivate)
+	{
+		if (!m_privateTransport || m_privateTransport->isRetired())
+		{
+			m_privateTransport = new NetworkTransport(true, QCoreApplication::instance());
+		}
+
+		return m_privateTransport;
+	}
+
+	if (!m_transport)
+	{
+		m_transport = new NetworkTransport(false, QCoreApplication::instance());
+	}
+
+	return m_transport;
+}
+
 NetworkCache* NetworkManagerFactory::getCache()
 {
 	if (!m_cache)
@@ -22,6 +22,7 @@
 #define MEERKAT_NETWORKMANAGERFACTORY_H
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QPointer>
 #include <QtNetwork/QAuthenticator>
 #include <QtNetwork/QNetworkCookieJar>
 #include <QtNetwork/QNetworkDiskCache>
@@ -46,6 +47,7 @@ struct UserAgentInformation
 class CookieJar;
 class NetworkCache;
 class NetworkManager;
+class NetworkTransport;
 
 class NetworkManagerFactory : public QObject
 {
@@ -68,6 +70,7 @@ public:
 	static void notifyAuthenticated(QAuthenticator *authenticator, bool wasAccepted);
 	static NetworkManagerFactory* getInstance();
 	static NetworkManager* getNetworkManager();
+	static NetworkTransport* getTransport(bool isPrivate);
 	static NetworkCache* getCache();
 	static CookieJar* getCookieJar();
 	static QString getAcceptLanguage();
@@ -89,6 +92,8 @@ protected slots:
 private:
 	static NetworkManagerFactory *m_instance;
 	static NetworkManager *m_networkManager;
+	static NetworkTransport *m_transport;
+	static QPointer<NetworkTransport> m_privateTransport;
 	static NetworkCache *m_cache;
 	static CookieJar *m_cookieJar;
 	static QString m_acceptLanguage;
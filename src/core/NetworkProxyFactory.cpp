@@ -206,7 +206,7 @@ QList<QNetworkProxy> NetworkProxyFactory::queryProxy(const QNetworkProxyQuery &q
 
 	if (m_proxyMode == AutomaticProxy && m_automaticProxy)
 	{
-		return m_automaticProxy->getProxy(query.url().toString(), query.peerHostName());
+		return m_automaticProxy->getProxy(query.url(), query.peerHostName());
 	}
 
 	return m_proxies[QLatin1String("NoProxy")];
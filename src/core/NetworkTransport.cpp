@@ -0,0 +1,228 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "NetworkTransport.h"
+#include "NetworkCache.h"
+#include "NetworkManagerFactory.h"
+
+#include <QtNetwork/QNetworkProxy>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QSslError>
+
+namespace Meerkat
+{
+
+class NetworkTransportCookieJar : public QNetworkCookieJar
+{
+public:
+	explicit NetworkTransportCookieJar(QObject *parent = nullptr) : QNetworkCookieJar(parent)
+	{
+	}
+
+	QList<QNetworkCookie> cookiesForUrl(const QUrl &url) const
+	{
+		Q_UNUSED(url)
+
+		return QList<QNetworkCookie>();
+	}
+
+	bool setCookiesFromUrl(const QList<QNetworkCookie> &cookies, const QUrl &url)
+	{
+		Q_UNUSED(cookies)
+		Q_UNUSED(url)
+
+		return false;
+	}
+};
+
+NetworkTransport::NetworkTransport(bool isPrivate, QObject *parent) : QNetworkAccessManager(parent),
+	m_replyCounter(0),
+	m_isPrivate(isPrivate),
+	m_isRetired(false)
+{
+	NetworkManagerFactory::initialize();
+
+	setCookieJar(new NetworkTransportCookieJar(this));
+
+	if (!isPrivate)
+	{
+		QNetworkDiskCache *cache(NetworkManagerFactory::getCache());
+
+		setCache(cache);
+
+		cache->setParent(QCoreApplication::instance());
+	}
+
+	connect(this, SIGNAL(authenticationRequired(QNetworkReply*,QAuthenticator*)), this, SLOT(handleAuthenticationRequired(QNetworkReply*,QAuthenticator*)));
+	connect(this, SIGNAL(proxyAuthenticationRequired(QNetworkProxy,QAuthenticator*)), this, SLOT(handleProxyAuthenticationRequired(QNetworkProxy,QAuthenticator*)));
+	connect(this, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)), this, SLOT(handleSslErrors(QNetworkReply*,QList<QSslError>)));
+	connect(this, SIGNAL(finished(QNetworkReply*)), this, SLOT(handleReplyFinished(QNetworkReply*)));
+	connect(NetworkManagerFactory::getInstance(), SIGNAL(onlineStateChanged(bool)), this, SLOT(handleOnlineStateChanged(bool)));
+}
+
+void NetworkTransport::handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator)
+{
+	if (m_owners.contains(reply) && m_owners[reply].manager)
+	{
+		QMetaObject::invokeMethod(m_owners[reply].manager, "authenticationRequired", Qt::DirectConnection, Q_ARG(QNetworkReply*, reply), Q_ARG(QAuthenticator*, authenticator));
+	}
+}
+
+void NetworkTransport::handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator)
+{
+	QNetworkReply *triggeringReply(nullptr);
+	QHash<QNetworkReply*, ReplyOwner>::const_iterator iterator;
+
+	for (iterator = m_owners.constBegin(); iterator != m_owners.constEnd(); ++iterator)
+	{
+		QNetworkReply *reply(iterator.key());
+
+		if (!iterator.value().manager || reply->isFinished() || reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid() || (triggeringReply && m_owners[triggeringReply].identifier < iterator.value().identifier))
+		{
+			continue;
+		}
+
+		const QList<QNetworkProxy> proxies(QNetworkProxyFactory::proxyForQuery(QNetworkProxyQuery(reply->url())));
+
+		for (int i = 0; i < proxies.count(); ++i)
+		{
+			if (proxies.at(i).hostName() == proxy.hostName() && proxies.at(i).port() == proxy.port())
+			{
+				triggeringReply = reply;
+
+				break;
+			}
+		}
+	}
+
+	if (triggeringReply)
+	{
+		QMetaObject::invokeMethod(m_owners[triggeringReply].manager, "proxyAuthenticationRequired", Qt::DirectConnection, Q_ARG(QNetworkProxy, proxy), Q_ARG(QAuthenticator*, authenticator));
+	}
+}
+
+void NetworkTransport::handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors)
+{
+	if (m_owners.contains(reply) && m_owners[reply].manager)
+	{
+		QMetaObject::invokeMethod(m_owners[reply].manager, "sslErrors", Qt::DirectConnection, Q_ARG(QNetworkReply*, reply), Q_ARG(QList<QSslError>, errors));
+	}
+}
+
+void NetworkTransport::handleReplyFinished(QNetworkReply *reply)
+{
+	if (m_owners.contains(reply) && m_owners[reply].manager)
+	{
+		QMetaObject::invokeMethod(m_owners[reply].manager, "finished", Qt::DirectConnection, Q_ARG(QNetworkReply*, reply));
+	}
+}
+
+void NetworkTransport::handleReplyMetaDataChanged()
+{
+	QNetworkReply *reply(qobject_cast<QNetworkReply*>(sender()));
+
+	if (!reply || !m_owners.contains(reply) || !m_owners[reply].cookieJar || static_cast<QNetworkRequest::LoadControl>(reply->request().attribute(QNetworkRequest::CookieSaveControlAttribute, QNetworkRequest::Automatic).toInt()) != QNetworkRequest::Automatic)
+	{
+		return;
+	}
+
+	const QList<QNetworkCookie> cookies(reply->header(QNetworkRequest::SetCookieHeader).value<QList<QNetworkCookie> >());
+
+	if (!cookies.isEmpty())
+	{
+		m_owners[reply].cookieJar->setCookiesFromUrl(cookies, reply->url());
+	}
+}
+
+void NetworkTransport::handleReplyDestroyed(QObject *object)
+{
+	m_owners.remove(static_cast<QNetworkReply*>(object));
+
+	if (m_isRetired && m_owners.isEmpty())
+	{
+		deleteLater();
+	}
+}
+
+void NetworkTransport::handleManagerDestroyed(QObject *object)
+{
+	m_managers.remove(object);
+
+	if (m_isPrivate && m_managers.isEmpty())
+	{
+		m_isRetired = true;
+
+		clearAccessCache();
+
+		if (m_owners.isEmpty())
+		{
+			deleteLater();
+		}
+	}
+}
+
+void NetworkTransport::handleOnlineStateChanged(bool isOnline)
+{
+	if (isOnline)
+	{
+		setNetworkAccessible(QNetworkAccessManager::Accessible);
+	}
+}
+
+QNetworkReply* NetworkTransport::createReply(QNetworkAccessManager *manager, QNetworkCookieJar *cookieJar, Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
+{
+	QNetworkRequest mutableRequest(request);
+
+	if (cookieJar && static_cast<QNetworkRequest::LoadControl>(request.attribute(QNetworkRequest::CookieLoadControlAttribute, QNetworkRequest::Automatic).toInt()) == QNetworkRequest::Automatic)
+	{
+		const QList<QNetworkCookie> cookies(cookieJar->cookiesForUrl(request.url()));
+
+		if (!cookies.isEmpty())
+		{
+			mutableRequest.setHeader(QNetworkRequest::CookieHeader, QVariant::fromValue(cookies));
+		}
+	}
+
+	QNetworkReply *reply(QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData));
+	ReplyOwner owner;
+	owner.manager = manager;
+	owner.cookieJar = cookieJar;
+	owner.identifier = ++m_replyCounter;
+
+	m_owners[reply] = owner;
+
+	if (manager && !m_managers.contains(manager))
+	{
+		m_managers.insert(manager);
+
+		connect(manager, SIGNAL(destroyed(QObject*)), this, SLOT(handleManagerDestroyed(QObject*)));
+	}
+
+	connect(reply, SIGNAL(metaDataChanged()), this, SLOT(handleReplyMetaDataChanged()));
+	connect(reply, SIGNAL(destroyed(QObject*)), this, SLOT(handleReplyDestroyed(QObject*)));
+
+	return reply;
+}
+
+bool NetworkTransport::isRetired() const
+{
+	return m_isRetired;
+}
+
+}
@@ -0,0 +1,69 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef MEERKAT_NETWORKTRANSPORT_H
+#define MEERKAT_NETWORKTRANSPORT_H
+
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkCookieJar>
+
+namespace Meerkat
+{
+
+class NetworkTransport : public QNetworkAccessManager
+{
+	Q_OBJECT
+
+public:
+	explicit NetworkTransport(bool isPrivate, QObject *parent = nullptr);
+
+	QNetworkReply* createReply(QNetworkAccessManager *manager, QNetworkCookieJar *cookieJar, Operation operation, const QNetworkRequest &request, QIODevice *outgoingData);
+	bool isRetired() const;
+
+protected slots:
+	void handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator);
+	void handleProxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
+	void handleSslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
+	void handleReplyFinished(QNetworkReply *reply);
+	void handleReplyMetaDataChanged();
+	void handleReplyDestroyed(QObject *object);
+	void handleManagerDestroyed(QObject *object);
+	void handleOnlineStateChanged(bool isOnline);
+
+private:
+	struct ReplyOwner
+	{
+		QPointer<QNetworkAccessManager> manager;
+		QPointer<QNetworkCookieJar> cookieJar;
+		quint64 identifier = 0;
+	};
+
+	QHash<QNetworkReply*, ReplyOwner> m_owners;
+	QSet<QObject*> m_managers;
+	quint64 m_replyCounter;
+	bool m_isPrivate;
+	bool m_isRetired;
+};
+
+}
+
+#endif
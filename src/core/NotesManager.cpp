@@ -19,7 +19,9 @@
 
 #include "NotesManager.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
 
 namespace Meerkat
@@ -35,6 +37,8 @@ NotesManager::NotesManager(QObject *parent) : QObject(parent),
 
 void NotesManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new NotesManager(parent);
@@ -66,12 +70,17 @@ void NotesManager::scheduleSave()
 
 NotesManager* NotesManager::getInstance()
 {
+	if (!m_instance)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
 	return m_instance;
 }
 
 BookmarksModel* NotesManager::getModel()
 {
-	if (!m_model && m_instance)
+	if (!m_model && getInstance())
 	{
 		m_model = new BookmarksModel(SessionsManager::getWritableDataPath(QLatin1String("notes.xbel")), BookmarksModel::NotesMode, m_instance);
 
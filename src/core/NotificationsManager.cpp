@@ -21,6 +21,7 @@
 #include "Application.h"
 #include "PlatformIntegration.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
 #include "../ui/MainWindow.h"
 
 #include <QtCore/QFile>
@@ -90,8 +91,20 @@ NotificationsManager::NotificationsManager(QObject *parent) : QObject(parent)
 	registerEvent(QT_TRANSLATE_NOOP("notifications", "Update Available"), QT_TRANSLATE_NOOP("notifications", "Update is available to be downloaded"));
 }
 
+NotificationsManager* NotificationsManager::getInstance()
+{
+	if (!m_instance)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
+	return m_instance;
+}
+
 void NotificationsManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new NotificationsManager(parent);
@@ -106,7 +119,7 @@ Notification* NotificationsManager::createNotification(int event, const QString
 
 	if (!definition.playSound.isEmpty())
 	{
-		QSoundEffect *effect(new QSoundEffect(m_instance));
+		QSoundEffect *effect(new QSoundEffect(getInstance()));
 		effect->setSource(QUrl::fromLocalFile(definition.playSound));
 		effect->setLoopCount(1);
 		effect->setVolume(0.5);
@@ -143,7 +156,7 @@ QString NotificationsManager::getEventName(int identifier)
 		return m_identifiers[identifier];
 	}
 
-	QString name(m_instance->metaObject()->enumerator(m_eventIdentifierEnumerator).valueToKey(identifier));
+	QString name(getInstance()->metaObject()->enumerator(m_eventIdentifierEnumerator).valueToKey(identifier));
 
 	if (!name.isEmpty())
 	{
@@ -157,6 +170,8 @@ QString NotificationsManager::getEventName(int identifier)
 
 EventDefinition NotificationsManager::getEventDefinition(int identifier)
 {
+	getInstance();
+
 	if (identifier < 0 || identifier >= m_definitions.count())
 	{
 		return EventDefinition();
@@ -174,6 +189,8 @@ EventDefinition NotificationsManager::getEventDefinition(int identifier)
 
 QVector<EventDefinition> NotificationsManager::getEventDefinitions()
 {
+	getInstance();
+
 	QSettings notificationsSettings(SessionsManager::getReadableDataPath(QLatin1String("notifications.ini")), QSettings::IniFormat);
 
 	for (int i = 0; i < m_definitions.count(); ++i)
@@ -19,8 +19,11 @@
 
 #include "PasswordsManager.h"
 #include "PasswordsStorageBackend.h"
+#include "Tracer.h"
 #include "../modules/backends/passwords/file/FilePasswordsStorageBackend.h"
 
+#include <QtCore/QCoreApplication>
+
 namespace Meerkat
 {
 
@@ -33,6 +36,8 @@ PasswordsManager::PasswordsManager(QObject *parent) : QObject(parent)
 
 void PasswordsManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new PasswordsManager(parent);
@@ -44,7 +49,7 @@ void PasswordsManager::createInstance(QObject *parent)
 
 void PasswordsManager::clearPasswords(const QString &host)
 {
-	if (m_backend)
+	if (getBackend())
 	{
 		m_backend->clearPasswords(host);
 	}
@@ -52,7 +57,7 @@ void PasswordsManager::clearPasswords(const QString &host)
 
 void PasswordsManager::clearPasswords(int period)
 {
-	if (m_backend)
+	if (getBackend())
 	{
 		m_backend->clearPasswords(period);
 	}
@@ -60,7 +65,7 @@ void PasswordsManager::clearPasswords(int period)
 
 void PasswordsManager::addPassword(const PasswordInformation &password)
 {
-	if (m_backend)
+	if (getBackend())
 	{
 		m_backend->addPassword(password);
 	}
@@ -68,7 +73,7 @@ void PasswordsManager::addPassword(const PasswordInformation &password)
 
 void PasswordsManager::removePassword(const PasswordsManager::PasswordInformation &password)
 {
-	if (m_backend)
+	if (getBackend())
 	{
 		m_backend->removePassword(password);
 	}
@@ -76,27 +81,42 @@ void PasswordsManager::removePassword(const PasswordsManager::PasswordInformatio
 
 PasswordsManager* PasswordsManager::getInstance()
 {
+	if (!m_instance)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
 	return m_instance;
 }
 
+PasswordsStorageBackend* PasswordsManager::getBackend()
+{
+	if (!m_backend)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
+	return m_backend;
+}
+
 QStringList PasswordsManager::getHosts()
 {
-	return (m_backend ? m_backend->getHosts() : QStringList());
+	return (getBackend() ? m_backend->getHosts() : QStringList());
 }
 
 QList<PasswordsManager::PasswordInformation> PasswordsManager::getPasswords(const QUrl &url, PasswordTypes types)
 {
-	return (m_backend ? m_backend->getPasswords(url, types) : QList<PasswordsManager::PasswordInformation>());
+	return (getBackend() ? m_backend->getPasswords(url, types) : QList<PasswordsManager::PasswordInformation>());
 }
 
 PasswordsManager::PasswordMatch PasswordsManager::hasPassword(const PasswordsManager::PasswordInformation &password)
 {
-	return (m_backend ? m_backend->hasPassword(password) : NoMatch);
+	return (getBackend() ? m_backend->hasPassword(password) : NoMatch);
 }
 
 bool PasswordsManager::hasPasswords(const QUrl &url, PasswordTypes types)
 {
-	return (m_backend ? m_backend->hasPasswords(url, types) : false);
+	return (getBackend() ? m_backend->hasPasswords(url, types) : false);
 }
 
 }
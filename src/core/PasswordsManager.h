@@ -89,6 +89,8 @@ public:
 protected:
 	explicit PasswordsManager(QObject *parent = nullptr);
 
+	static PasswordsStorageBackend* getBackend();
+
 private:
 	static PasswordsManager *m_instance;
 	static PasswordsStorageBackend *m_backend;
@@ -0,0 +1,253 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "PreconnectManager.h"
+#include "ContentBlockingManager.h"
+#include "NetworkManagerFactory.h"
+#include "NetworkTransport.h"
+#include "SessionsManager.h"
+#include "SettingsManager.h"
+#include "Tracer.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QTextStream>
+#include <QtCore/QTimerEvent>
+
+#define PRECONNECT_HOST_BUDGET 2
+#define PRECONNECT_BUDGET_PERIOD 30000
+#define PRECONNECT_VALIDITY_PERIOD 10000
+
+namespace Meerkat
+{
+
+PreconnectManager* PreconnectManager::m_instance(nullptr);
+
+PreconnectManager::PreconnectManager(QObject *parent) : QObject(parent),
+	m_expirationTimer(0),
+	m_isEnabled(false)
+{
+	m_timer.start();
+
+	optionChanged(SettingsManager::Network_EnablePreconnectOption, SettingsManager::getValue(SettingsManager::Network_EnablePreconnectOption));
+
+	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int,QVariant)));
+}
+
+void PreconnectManager::createInstance(QObject *parent)
+{
+	if (!m_instance)
+	{
+		m_instance = new PreconnectManager(parent);
+	}
+}
+
+void PreconnectManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_expirationTimer)
+	{
+		return;
+	}
+
+	const qint64 currentTime(m_timer.elapsed());
+	QHash<QString, qint64>::iterator connectionsIterator(m_connections.begin());
+
+	while (connectionsIterator != m_connections.end())
+	{
+		if ((currentTime - connectionsIterator.value()) >= PRECONNECT_VALIDITY_PERIOD)
+		{
+			connectionsIterator = m_connections.erase(connectionsIterator);
+
+			++m_statistics.expired;
+		}
+		else
+		{
+			++connectionsIterator;
+		}
+	}
+
+	QHash<QString, HostBudget>::iterator budgetsIterator(m_budgets.begin());
+
+	while (budgetsIterator != m_budgets.end())
+	{
+		if ((currentTime - budgetsIterator.value().periodStart) >= PRECONNECT_BUDGET_PERIOD)
+		{
+			budgetsIterator = m_budgets.erase(budgetsIterator);
+		}
+		else
+		{
+			++budgetsIterator;
+		}
+	}
+
+	if (m_connections.isEmpty() && m_budgets.isEmpty())
+	{
+		killTimer(m_expirationTimer);
+
+		m_expirationTimer = 0;
+	}
+}
+
+void PreconnectManager::optionChanged(int identifier, const QVariant &value)
+{
+	if (identifier == SettingsManager::Network_EnablePreconnectOption)
+	{
+		m_isEnabled = value.toBool();
+
+		if (!m_isEnabled)
+		{
+			m_connections.clear();
+		}
+	}
+}
+
+void PreconnectManager::preconnect(const QUrl &url, const QUrl &baseUrl, const QVector<int> &contentBlockingProfiles)
+{
+	if (!isEnabled() || url.host().isEmpty() || (url.scheme() != QLatin1String("http") && url.scheme() != QLatin1String("https")))
+	{
+		return;
+	}
+
+	MEERKAT_TRACE_FUNCTION("network");
+
+	++m_instance->m_statistics.requested;
+
+	if (!contentBlockingProfiles.isEmpty() && ContentBlockingManager::checkUrl(contentBlockingProfiles, (baseUrl.isEmpty() ? url : baseUrl), url, NetworkManager::MainFrameType).isBlocked)
+	{
+		++m_instance->m_statistics.blocked;
+
+		return;
+	}
+
+	const QString origin(getOrigin(url));
+	const qint64 currentTime(m_instance->m_timer.elapsed());
+
+	if (m_instance->m_connections.contains(origin) && (currentTime - m_instance->m_connections[origin]) < PRECONNECT_VALIDITY_PERIOD)
+	{
+		return;
+	}
+
+	HostBudget &budget(m_instance->m_budgets[url.host()]);
+
+	if ((currentTime - budget.periodStart) >= PRECONNECT_BUDGET_PERIOD)
+	{
+		budget.periodStart = currentTime;
+		budget.amount = 0;
+	}
+
+	if (budget.amount >= PRECONNECT_HOST_BUDGET)
+	{
+		++m_instance->m_statistics.throttled;
+
+		return;
+	}
+
+	++budget.amount;
+	++m_instance->m_statistics.performed;
+
+	m_instance->m_connections[origin] = currentTime;
+
+	if (url.scheme() == QLatin1String("https"))
+	{
+		NetworkManagerFactory::getTransport(false)->connectToHostEncrypted(url.host(), url.port(443));
+	}
+	else
+	{
+		NetworkManagerFactory::getTransport(false)->connectToHost(url.host(), url.port(80));
+	}
+
+	if (m_instance->m_expirationTimer == 0)
+	{
+		m_instance->m_expirationTimer = m_instance->startTimer(PRECONNECT_VALIDITY_PERIOD);
+	}
+}
+
+void PreconnectManager::notifyRequest(const QUrl &url)
+{
+	if (!m_instance || m_instance->m_connections.isEmpty())
+	{
+		return;
+	}
+
+	const QString origin(getOrigin(url));
+
+	if (m_instance->m_connections.contains(origin))
+	{
+		const qint64 connectionTime(m_instance->m_connections.take(origin));
+
+		if ((m_instance->m_timer.elapsed() - connectionTime) < PRECONNECT_VALIDITY_PERIOD)
+		{
+			++m_instance->m_statistics.followed;
+		}
+		else
+		{
+			++m_instance->m_statistics.expired;
+		}
+	}
+}
+
+PreconnectManager* PreconnectManager::getInstance()
+{
+	if (!m_instance)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
+	return m_instance;
+}
+
+PreconnectManager::PreconnectStatistics PreconnectManager::getStatistics()
+{
+	return (m_instance ? m_instance->m_statistics : PreconnectStatistics());
+}
+
+QString PreconnectManager::getReport()
+{
+	const PreconnectStatistics statistics(getStatistics());
+	const QList<QPair<QString, int> > values({qMakePair(QString(QLatin1String("Requested")), statistics.requested), qMakePair(QString(QLatin1String("Performed")), statistics.performed), qMakePair(QString(QLatin1String("Throttled")), statistics.throttled), qMakePair(QString(QLatin1String("Blocked")), statistics.blocked), qMakePair(QString(QLatin1String("Followed")), statistics.followed), qMakePair(QString(QLatin1String("Expired")), statistics.expired)});
+	QString report;
+	QTextStream stream(&report);
+	stream.setFieldAlignment(QTextStream::AlignLeft);
+	stream << QLatin1String("Preconnect:\n");
+
+	for (int i = 0; i < values.count(); ++i)
+	{
+		stream << QLatin1Char('\t');
+		stream.setFieldWidth(20);
+		stream << values.at(i).first;
+		stream << values.at(i).second;
+		stream.setFieldWidth(0);
+		stream << QLatin1Char('\n');
+	}
+
+	stream << QLatin1Char('\n');
+
+	return report;
+}
+
+QString PreconnectManager::getOrigin(const QUrl &url)
+{
+	return url.scheme() + QLatin1String("://") + url.host() + QLatin1Char(':') + QString::number(url.port((url.scheme() == QLatin1String("https")) ? 443 : 80));
+}
+
+bool PreconnectManager::isEnabled()
+{
+	return (getInstance()->m_isEnabled && !SessionsManager::isPrivate() && !NetworkManagerFactory::isWorkingOffline());
+}
+
+}
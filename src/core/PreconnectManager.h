@@ -0,0 +1,83 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef MEERKAT_PRECONNECTMANAGER_H
+#define MEERKAT_PRECONNECTMANAGER_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+#include <QtCore/QVector>
+
+namespace Meerkat
+{
+
+class PreconnectManager : public QObject
+{
+	Q_OBJECT
+
+public:
+	struct PreconnectStatistics
+	{
+		int requested = 0;
+		int performed = 0;
+		int throttled = 0;
+		int blocked = 0;
+		int followed = 0;
+		int expired = 0;
+	};
+
+	static void createInstance(QObject *parent = nullptr);
+	static void preconnect(const QUrl &url, const QUrl &baseUrl, const QVector<int> &contentBlockingProfiles);
+	static void notifyRequest(const QUrl &url);
+	static PreconnectManager* getInstance();
+	static PreconnectStatistics getStatistics();
+	static QString getReport();
+	static bool isEnabled();
+
+protected:
+	struct HostBudget
+	{
+		qint64 periodStart = 0;
+		int amount = 0;
+	};
+
+	explicit PreconnectManager(QObject *parent = nullptr);
+
+	void timerEvent(QTimerEvent *event);
+	static QString getOrigin(const QUrl &url);
+
+protected slots:
+	void optionChanged(int identifier, const QVariant &value);
+
+private:
+	QElapsedTimer m_timer;
+	QHash<QString, HostBudget> m_budgets;
+	QHash<QString, qint64> m_connections;
+	PreconnectStatistics m_statistics;
+	int m_expirationTimer;
+	bool m_isEnabled;
+
+	static PreconnectManager *m_instance;
+};
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "ThemesManager.h"
+#include "Tracer.h"
 
 #include <QtCore/QBuffer>
 #include <QtCore/QDir>
@@ -45,6 +46,8 @@ SearchEnginesManager::SearchEnginesManager(QObject *parent) : QObject(parent)
 
 void SearchEnginesManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new SearchEnginesManager(parent);
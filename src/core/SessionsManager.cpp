@@ -21,13 +21,16 @@
 #include "SessionsManager.h"
 #include "ActionsManager.h"
 #include "Application.h"
+#include "Tracer.h"
 #include "Utils.h"
 #include "WindowsManager.h"
 #include "../ui/MainWindow.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QFileInfo>
 #include <QtCore/QSaveFile>
 #include <QtCore/QSettings>
+#include <QtCore/QTextStream>
 
 namespace Meerkat
 {
@@ -40,6 +43,7 @@ QString SessionsManager::m_cachePath;
 QString SessionsManager::m_profilePath;
 QList<MainWindow*> SessionsManager::m_windows;
 QList<SessionMainWindow> SessionsManager::m_closedWindows;
+QHash<QString, SessionSummary> SessionsManager::m_summaries;
 bool SessionsManager::m_isDirty(false);
 bool SessionsManager::m_isPrivate(false);
 bool SessionsManager::m_isReadOnly(false);
@@ -285,6 +289,89 @@ SessionInformation SessionsManager::getSession(const QString &path)
 	return session;
 }
 
+SessionSummary SessionsManager::getSessionSummary(const QString &path)
+{
+	const QString sessionPath(getSessionPath(path));
+	const QDateTime lastModified(QFileInfo(sessionPath).lastModified());
+
+	if (m_summaries.contains(sessionPath) && m_summaries[sessionPath].lastModified == lastModified)
+	{
+		SessionSummary summary(m_summaries[sessionPath]);
+		summary.path = path;
+
+		return summary;
+	}
+
+	SessionSummary summary;
+	summary.path = path;
+	summary.title = ((path == QLatin1String("default")) ? tr("Default") : tr("(Untitled)"));
+	summary.lastModified = lastModified;
+
+	QFile file(sessionPath);
+
+	if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		QTextStream stream(&file);
+		stream.setCodec("UTF-8");
+
+		QString section;
+
+		while (!stream.atEnd())
+		{
+			const QString line(stream.readLine());
+
+			if (line.startsWith(QLatin1Char('[')))
+			{
+				section = line.mid(1, (line.lastIndexOf(QLatin1Char(']')) - 1));
+
+				continue;
+			}
+
+			const int separator(line.indexOf(QLatin1Char('=')));
+
+			if (separator < 0)
+			{
+				continue;
+			}
+
+			const QString key(line.left(separator));
+
+			if (section == QLatin1String("Session"))
+			{
+				QString value(line.mid(separator + 1));
+
+				if (key == QLatin1String("title"))
+				{
+					if (value.length() > 1 && value.startsWith(QLatin1Char('"')) && value.endsWith(QLatin1Char('"')))
+					{
+						value = value.mid(1, (value.length() - 2)).replace(QLatin1String("\\\""), QLatin1String("\"")).replace(QLatin1String("\\n"), QLatin1String("\n"));
+					}
+
+					summary.title = value;
+				}
+				else if (key == QLatin1String("clean"))
+				{
+					summary.isClean = (value != QLatin1String("false"));
+				}
+				else if (key == QLatin1String("windows"))
+				{
+					summary.windows = value.toInt();
+				}
+			}
+			else if (key == QLatin1String("windows") && section.endsWith(QLatin1String("/Properties")) && section.count(QLatin1Char('/')) == 1)
+			{
+				summary.tabs += line.mid(separator + 1).toInt();
+			}
+		}
+
+		file.close();
+	}
+
+	m_summaries[sessionPath] = summary;
+
+	return summary;
+}
+
 QList<MainWindow*> SessionsManager::getWindows()
 {
 	return m_windows;
@@ -347,6 +434,8 @@ bool SessionsManager::restoreClosedWindow(int index)
 
 bool SessionsManager::restoreSession(const SessionInformation &session, MainWindow *window, bool isPrivate)
 {
+	MEERKAT_TRACE_FUNCTION("session");
+
 	if (session.windows.isEmpty())
 	{
 		if (m_sessionPath.isEmpty() && session.path == QLatin1String("default"))
@@ -522,13 +611,33 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 		}
 	}
 
-	return file.commit();
+	if (!file.commit())
+	{
+		return false;
+	}
+
+	SessionSummary summary;
+	summary.title = session.title;
+	summary.lastModified = QFileInfo(path).lastModified();
+	summary.windows = session.windows.count();
+	summary.isClean = session.isClean;
+
+	for (int i = 0; i < session.windows.count(); ++i)
+	{
+		summary.tabs += session.windows.at(i).windows.count();
+	}
+
+	m_summaries[QDir::toNativeSeparators(path)] = summary;
+
+	return true;
 }
 
 bool SessionsManager::deleteSession(const QString &path)
 {
 	const QString cleanPath(getSessionPath(path, true));
 
+	m_summaries.remove(cleanPath);
+
 	if (QFile::exists(cleanPath))
 	{
 		return QFile::remove(cleanPath);
@@ -23,6 +23,7 @@
 #include "SettingsManager.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
 #include <QtCore/QRect>
 #include <QtCore/QPointer>
 
@@ -108,6 +109,16 @@ struct SessionInformation
 	bool isClean = true;
 };
 
+struct SessionSummary
+{
+	QString path;
+	QString title;
+	QDateTime lastModified;
+	int windows = 0;
+	int tabs = 0;
+	bool isClean = true;
+};
+
 class MainWindow;
 class WindowsManager;
 
@@ -133,6 +144,7 @@ public:
 	static QString getWritableDataPath(const QString &path);
 	static QString getSessionPath(const QString &path, bool isBound = false);
 	static SessionInformation getSession(const QString &path);
+	static SessionSummary getSessionSummary(const QString &path);
 	static QStringList getClosedWindows();
 	static QStringList getSessions();
 	static QList<MainWindow*> getWindows();
@@ -163,6 +175,7 @@ private:
 	static QString m_profilePath;
 	static QList<MainWindow*> m_windows;
 	static QList<SessionMainWindow> m_closedWindows;
+	static QHash<QString, SessionSummary> m_summaries;
 	static bool m_isDirty;
 	static bool m_isPrivate;
 	static bool m_isReadOnly;
@@ -122,6 +122,8 @@ void SettingsManager::createInstance(const QString &path, QObject *parent)
 	registerOption(Browser_TransferStartingActionOption, QLatin1String("openTab"), EnumerationType, QStringList({QLatin1String("openTab"), QLatin1String("openBackgroundTab"), QLatin1String("openPanel"), QLatin1String("doNothing")}));
 	registerOption(Cache_DiskCacheLimitOption, 51200, IntegerType);
 	registerOption(Cache_PagesInMemoryLimitOption, 5, IntegerType);
+	registerOption(Cache_ThumbnailsDiskCacheLimitOption, 20480, IntegerType);
+	registerOption(Cache_ThumbnailsMemoryCacheLimitOption, 10240, IntegerType);
 	registerOption(Choices_WarnFormResendOption, true, BooleanType);
 	registerOption(Choices_WarnLowDiskSpaceOption, QLatin1String("warn"), EnumerationType, QStringList({QLatin1String("warn"), QLatin1String("continueReadOnly"), QLatin1String("continueReadWrite")}));
 	registerOption(Choices_WarnOpenBookmarkFolderOption, true, BooleanType);
@@ -178,6 +180,7 @@ void SettingsManager::createInstance(const QString &path, QObject *parent)
 	registerOption(Network_CookiesKeepModeOption, QLatin1String("keepUntilExpires"), EnumerationType, QStringList({QLatin1String("keepUntilExpires"), QLatin1String("keepUntilExit"), QLatin1String("ask")}));
 	registerOption(Network_CookiesPolicyOption, QLatin1String("acceptAll"), EnumerationType, QStringList({QLatin1String("acceptAll"), QLatin1String("acceptExisting"), QLatin1String("readOnly"), QLatin1String("ignore")}));
 	registerOption(Network_DoNotTrackPolicyOption, QLatin1String("skip"), EnumerationType, QStringList({QLatin1String("skip"), QLatin1String("allow"), QLatin1String("doNotAllow")}));
+	registerOption(Network_EnablePreconnectOption, false, BooleanType);
 	registerOption(Network_EnableReferrerOption, true, BooleanType);
 	registerOption(Network_ProxyModeOption, QLatin1String("system"), EnumerationType, QStringList({QLatin1String("noproxy"), QLatin1String("manual"), QLatin1String("system"), QLatin1String("automatic")}));
 	registerOption(Network_ThirdPartyCookiesAcceptedHostsOption, QStringList(), ListType);
@@ -102,6 +102,8 @@ public:
 		Browser_TransferStartingActionOption,
 		Cache_DiskCacheLimitOption,
 		Cache_PagesInMemoryLimitOption,
+		Cache_ThumbnailsDiskCacheLimitOption,
+		Cache_ThumbnailsMemoryCacheLimitOption,
 		Choices_WarnFormResendOption,
 		Choices_WarnLowDiskSpaceOption,
 		Choices_WarnOpenBookmarkFolderOption,
@@ -158,6 +160,7 @@ public:
 		Network_CookiesKeepModeOption,
 		Network_CookiesPolicyOption,
 		Network_DoNotTrackPolicyOption,
+		Network_EnablePreconnectOption,
 		Network_EnableReferrerOption,
 		Network_ProxyModeOption,
 		Network_ThirdPartyCookiesAcceptedHostsOption,
@@ -19,6 +19,9 @@
 
 #include "SpellCheckManager.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
+
+#include <QtCore/QCoreApplication>
 
 namespace Meerkat
 {
@@ -41,6 +44,8 @@ SpellCheckManager::~SpellCheckManager()
 
 void SpellCheckManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new SpellCheckManager(parent);
@@ -54,12 +59,19 @@ void SpellCheckManager::createInstance(QObject *parent)
 
 SpellCheckManager* SpellCheckManager::getInstance()
 {
+	if (!m_instance)
+	{
+		createInstance(QCoreApplication::instance());
+	}
+
 	return m_instance;
 }
 
 QString SpellCheckManager::getDefaultDictionary()
 {
 #ifdef MEERKAT_ENABLE_SPELLCHECK
+	getInstance();
+
 	return m_speller->defaultLanguage();
 #else
 	return QString();
@@ -71,6 +83,8 @@ QList<SpellCheckManager::DictionaryInformation> SpellCheckManager::getDictionari
 	QList<DictionaryInformation> dictionaries;
 
 #ifdef MEERKAT_ENABLE_SPELLCHECK
+	getInstance();
+
 	const QMap<QString, QString> availableDictionaries(m_speller->availableDictionaries());
 	QMap<QString, QString>::const_iterator iterator;
 
@@ -19,6 +19,7 @@
 
 #include "ThemesManager.h"
 #include "SettingsManager.h"
+#include "Tracer.h"
 
 #include <QtGui/QIcon>
 
@@ -37,6 +38,8 @@ ThemesManager::ThemesManager(QObject *parent) : QObject(parent)
 
 void ThemesManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new ThemesManager(parent);
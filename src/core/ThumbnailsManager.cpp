@@ -0,0 +1,379 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "ThumbnailsManager.h"
+#include "SessionsManager.h"
+#include "SettingsManager.h"
+#include "Tracer.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QSaveFile>
+
+namespace Meerkat
+{
+
+ThumbnailsManager* ThumbnailsManager::m_instance(nullptr);
+
+ThumbnailsManager::ThumbnailsManager(QObject *parent) : QObject(parent),
+	m_diskUsage(0),
+	m_diskLimit(0),
+	m_isIndexLoaded(false)
+{
+	if (!SessionsManager::isPrivate() && !SessionsManager::getCachePath().isEmpty())
+	{
+		m_cachePath = SessionsManager::getCachePath() + QLatin1String("/thumbnails/");
+	}
+
+	optionChanged(SettingsManager::Cache_ThumbnailsDiskCacheLimitOption);
+	optionChanged(SettingsManager::Cache_ThumbnailsMemoryCacheLimitOption);
+
+	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int)));
+}
+
+void ThumbnailsManager::createInstance(QObject *parent)
+{
+	MEERKAT_TRACE_FUNCTION("startup");
+
+	if (!m_instance)
+	{
+		m_instance = new ThumbnailsManager(parent);
+	}
+}
+
+void ThumbnailsManager::optionChanged(int identifier)
+{
+	if (identifier == SettingsManager::Cache_ThumbnailsDiskCacheLimitOption)
+	{
+		m_diskLimit = (SettingsManager::getValue(SettingsManager::Cache_ThumbnailsDiskCacheLimitOption).toLongLong() * 1024);
+
+		if (m_isIndexLoaded)
+		{
+			updateIndex(QString(), 0);
+		}
+	}
+	else if (identifier == SettingsManager::Cache_ThumbnailsMemoryCacheLimitOption)
+	{
+		m_pixmaps.setMaxCost(qMax(1, SettingsManager::getValue(SettingsManager::Cache_ThumbnailsMemoryCacheLimitOption).toInt()));
+	}
+}
+
+void ThumbnailsManager::handleTaskFinished()
+{
+	QFutureWatcher<ThumbnailTask> *watcher(static_cast<QFutureWatcher<ThumbnailTask>*>(sender()));
+
+	if (!watcher)
+	{
+		return;
+	}
+
+	const ThumbnailTask task(watcher->result());
+
+	watcher->deleteLater();
+
+	m_pendingLoads.remove(task.key);
+
+	if (task.needsScaling)
+	{
+		if (task.fileSize > 0)
+		{
+			updateIndex(task.key, task.fileSize);
+		}
+	}
+	else
+	{
+		if (task.image.isNull() && m_files.contains(task.key))
+		{
+			m_diskUsage -= m_files.take(task.key);
+			m_filesOrder.removeAll(task.key);
+		}
+	}
+
+	if (task.image.isNull())
+	{
+		if (task.needsScaling)
+		{
+			emit thumbnailFailed(task.url, task.size);
+		}
+
+		return;
+	}
+
+	QPixmap *pixmap(new QPixmap(QPixmap::fromImage(task.image)));
+	pixmap->setDevicePixelRatio(task.devicePixelRatio);
+
+	m_pixmaps.insert(task.key, pixmap, getCost(*pixmap));
+
+	emit thumbnailAvailable(task.url, task.size);
+}
+
+void ThumbnailsManager::scheduleTask(const ThumbnailTask &task)
+{
+	QFutureWatcher<ThumbnailTask> *watcher(new QFutureWatcher<ThumbnailTask>(this));
+
+	connect(watcher, SIGNAL(finished()), this, SLOT(handleTaskFinished()));
+
+	watcher->setFuture(QtConcurrent::run(&ThumbnailsManager::processTask, task));
+}
+
+void ThumbnailsManager::loadIndex()
+{
+	if (m_isIndexLoaded)
+	{
+		return;
+	}
+
+	m_isIndexLoaded = true;
+
+	if (m_cachePath.isEmpty())
+	{
+		return;
+	}
+
+	QDir().mkpath(m_cachePath);
+
+	const QFileInfoList entries(QDir(m_cachePath).entryInfoList(QStringList(QLatin1String("*.png")), QDir::Files, (QDir::Time | QDir::Reversed)));
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		const QString key(entries.at(i).completeBaseName());
+
+		m_files[key] = entries.at(i).size();
+		m_filesOrder.append(key);
+		m_diskUsage += entries.at(i).size();
+	}
+
+	updateIndex(QString(), 0);
+}
+
+void ThumbnailsManager::updateIndex(const QString &key, qint64 size)
+{
+	if (!key.isEmpty())
+	{
+		if (m_files.contains(key))
+		{
+			m_diskUsage -= m_files[key];
+			m_filesOrder.removeAll(key);
+		}
+
+		m_files[key] = size;
+		m_filesOrder.append(key);
+		m_diskUsage += size;
+	}
+
+	while (m_diskUsage > m_diskLimit && m_filesOrder.count() > 1)
+	{
+		const QString oldestKey(m_filesOrder.takeFirst());
+
+		m_diskUsage -= m_files.take(oldestKey);
+
+		QFile::remove(getPath(oldestKey));
+	}
+}
+
+void ThumbnailsManager::storeThumbnail(const QUrl &url, const QImage &image, const QSize &size, qreal devicePixelRatio, bool isPrivate)
+{
+	if (!m_instance || image.isNull())
+	{
+		return;
+	}
+
+	m_instance->loadIndex();
+
+	ThumbnailTask task;
+	task.url = url;
+	task.image = image;
+	task.key = getKey(url, size, devicePixelRatio, isPrivate);
+	task.path = (isPrivate ? QString() : m_instance->getPath(task.key));
+	task.size = size;
+	task.devicePixelRatio = devicePixelRatio;
+	task.needsScaling = true;
+
+	m_instance->scheduleTask(task);
+}
+
+void ThumbnailsManager::importThumbnail(const QUrl &url, const QString &path, const QSize &size)
+{
+	if (!m_instance || path.isEmpty())
+	{
+		return;
+	}
+
+	m_instance->loadIndex();
+
+	ThumbnailTask task;
+	task.url = url;
+	task.key = getKey(url, size, 1);
+	task.path = m_instance->getPath(task.key);
+	task.sourcePath = path;
+	task.size = size;
+	task.needsScaling = true;
+
+	if (m_instance->m_pendingLoads.contains(task.key))
+	{
+		return;
+	}
+
+	m_instance->m_pendingLoads.insert(task.key);
+	m_instance->scheduleTask(task);
+}
+
+void ThumbnailsManager::removeThumbnail(const QUrl &url, const QSize &size, qreal devicePixelRatio)
+{
+	if (!m_instance)
+	{
+		return;
+	}
+
+	m_instance->loadIndex();
+
+	const QString key(getKey(url, size, devicePixelRatio));
+
+	m_instance->m_pixmaps.remove(key);
+
+	if (m_instance->m_files.contains(key))
+	{
+		m_instance->m_diskUsage -= m_instance->m_files.take(key);
+		m_instance->m_filesOrder.removeAll(key);
+
+		QFile::remove(m_instance->getPath(key));
+	}
+}
+
+ThumbnailsManager* ThumbnailsManager::getInstance()
+{
+	return m_instance;
+}
+
+ThumbnailsManager::ThumbnailTask ThumbnailsManager::processTask(ThumbnailTask task)
+{
+	if (task.needsScaling)
+	{
+		if (!task.sourcePath.isEmpty() && !task.image.load(task.sourcePath, "png"))
+		{
+			QFile::remove(task.sourcePath);
+
+			return task;
+		}
+
+		task.image = task.image.scaled((task.size * task.devicePixelRatio), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+		if (!task.path.isEmpty() && !task.image.isNull())
+		{
+			QSaveFile file(task.path);
+
+			if (file.open(QIODevice::WriteOnly) && task.image.save(&file, "png") && file.commit())
+			{
+				task.fileSize = QFileInfo(task.path).size();
+
+				if (!task.sourcePath.isEmpty())
+				{
+					QFile::remove(task.sourcePath);
+				}
+			}
+		}
+	}
+	else
+	{
+		task.image.load(task.path, "png");
+	}
+
+	return task;
+}
+
+QString ThumbnailsManager::getKey(const QUrl &url, const QSize &size, qreal devicePixelRatio, bool isPrivate)
+{
+//Keyed by what is requested rather than by image content, since a lookup has to succeed before anything is rendered
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(url.adjusted(QUrl::RemoveFragment).toString().toUtf8());
+	hash.addData(QStringLiteral("|%1x%2@%3").arg(size.width()).arg(size.height()).arg(devicePixelRatio).toLatin1());
+
+	return (isPrivate ? QLatin1String("private-") : QString()) + QString::fromLatin1(hash.result().toHex());
+}
+
+QString ThumbnailsManager::getPath(const QString &key) const
+{
+	return (m_cachePath.isEmpty() ? QString() : (m_cachePath + key + QLatin1String(".png")));
+}
+
+QPixmap ThumbnailsManager::getThumbnail(const QUrl &url, const QSize &size, qreal devicePixelRatio, bool isPrivate)
+{
+	if (!m_instance || url.isEmpty())
+	{
+		return QPixmap();
+	}
+
+	const QString key(getKey(url, size, devicePixelRatio, isPrivate));
+	QPixmap *pixmap(m_instance->m_pixmaps.object(key));
+
+	if (pixmap)
+	{
+		return *pixmap;
+	}
+
+	if (isPrivate)
+	{
+		return QPixmap();
+	}
+
+	m_instance->loadIndex();
+
+	if (m_instance->m_files.contains(key) && !m_instance->m_pendingLoads.contains(key))
+	{
+		ThumbnailTask task;
+		task.url = url;
+		task.key = key;
+		task.path = m_instance->getPath(key);
+		task.size = size;
+		task.devicePixelRatio = devicePixelRatio;
+
+		m_instance->m_filesOrder.removeAll(key);
+		m_instance->m_filesOrder.append(key);
+		m_instance->m_pendingLoads.insert(key);
+		m_instance->scheduleTask(task);
+	}
+
+	return QPixmap();
+}
+
+int ThumbnailsManager::getCost(const QPixmap &pixmap)
+{
+	return qMax(1, ((pixmap.width() * pixmap.height() * pixmap.depth()) / 8192));
+}
+
+bool ThumbnailsManager::hasThumbnail(const QUrl &url, const QSize &size, qreal devicePixelRatio)
+{
+	if (!m_instance)
+	{
+		return false;
+	}
+
+	m_instance->loadIndex();
+
+	const QString key(getKey(url, size, devicePixelRatio));
+
+	return (m_instance->m_pixmaps.contains(key) || m_instance->m_files.contains(key) || m_instance->m_pendingLoads.contains(key));
+}
+
+}
@@ -0,0 +1,94 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef MEERKAT_THUMBNAILSMANAGER_H
+#define MEERKAT_THUMBNAILSMANAGER_H
+
+#include <QtCore/QCache>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QSize>
+#include <QtCore/QUrl>
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
+
+namespace Meerkat
+{
+
+class ThumbnailsManager : public QObject
+{
+	Q_OBJECT
+
+public:
+	struct ThumbnailTask
+	{
+		QUrl url;
+		QImage image;
+		QString key;
+		QString path;
+		QString sourcePath;
+		QSize size;
+		qint64 fileSize = 0;
+		qreal devicePixelRatio = 1;
+		bool needsScaling = false;
+	};
+
+	static void createInstance(QObject *parent = nullptr);
+	static void storeThumbnail(const QUrl &url, const QImage &image, const QSize &size, qreal devicePixelRatio = 1, bool isPrivate = false);
+	static void importThumbnail(const QUrl &url, const QString &path, const QSize &size);
+	static void removeThumbnail(const QUrl &url, const QSize &size, qreal devicePixelRatio = 1);
+	static ThumbnailsManager* getInstance();
+	static QPixmap getThumbnail(const QUrl &url, const QSize &size, qreal devicePixelRatio = 1, bool isPrivate = false);
+	static bool hasThumbnail(const QUrl &url, const QSize &size, qreal devicePixelRatio = 1);
+
+protected:
+	explicit ThumbnailsManager(QObject *parent = nullptr);
+
+	void scheduleTask(const ThumbnailTask &task);
+	void loadIndex();
+	void updateIndex(const QString &key, qint64 size);
+	static ThumbnailTask processTask(ThumbnailTask task);
+	static QString getKey(const QUrl &url, const QSize &size, qreal devicePixelRatio, bool isPrivate = false);
+	QString getPath(const QString &key) const;
+	static int getCost(const QPixmap &pixmap);
+
+protected slots:
+	void optionChanged(int identifier);
+	void handleTaskFinished();
+
+private:
+	QString m_cachePath;
+	QCache<QString, QPixmap> m_pixmaps;
+	QHash<QString, qint64> m_files;
+	QStringList m_filesOrder;
+	QSet<QString> m_pendingLoads;
+	qint64 m_diskUsage;
+	qint64 m_diskLimit;
+	bool m_isIndexLoaded;
+
+	static ThumbnailsManager *m_instance;
+
+signals:
+	void thumbnailAvailable(const QUrl &url, const QSize &size);
+	void thumbnailFailed(const QUrl &url, const QSize &size);
+};
+
+}
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "ToolBarsManager.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
 #include "Utils.h"
 #include "../ui/BookmarksComboBoxWidget.h"
 #include "../ui/BookmarksBarDialog.h"
@@ -54,6 +55,8 @@ ToolBarsManager::ToolBarsManager(QObject *parent) : QObject(parent),
 
 void ToolBarsManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new ToolBarsManager(parent);
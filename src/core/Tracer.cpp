@@ -0,0 +1,152 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "Tracer.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QThreadStorage>
+
+#define TRACE_BUFFER_SIZE 16384
+
+namespace Meerkat
+{
+
+QString Tracer::m_path;
+QElapsedTimer Tracer::m_timer;
+QMutex Tracer::m_buffersMutex;
+QVector<QSharedPointer<Tracer::TraceBuffer> > Tracer::m_buffers;
+QAtomicInt Tracer::m_isEnabled(0);
+
+static QThreadStorage<QSharedPointer<Tracer::TraceBuffer> > traceBuffers;
+
+void Tracer::start(const QString &path)
+{
+	if (path.isEmpty() || isEnabled())
+	{
+		return;
+	}
+
+	m_path = path;
+	m_timer.start();
+	m_isEnabled.store(1);
+}
+
+void Tracer::addEvent(const char *category, const char *name, qint64 start, qint64 duration)
+{
+	TraceBuffer *buffer(getBuffer());
+	QMutexLocker locker(&buffer->mutex);
+	TraceEvent &event(buffer->events[buffer->position]);
+	event.category = category;
+	event.name = name;
+	event.start = start;
+	event.duration = duration;
+
+	++buffer->position;
+
+	if (buffer->position == buffer->events.count())
+	{
+		buffer->position = 0;
+		buffer->isFull = true;
+	}
+}
+
+Tracer::TraceBuffer* Tracer::getBuffer()
+{
+	if (!traceBuffers.hasLocalData())
+	{
+		QSharedPointer<TraceBuffer> buffer(new TraceBuffer());
+		buffer->events.resize(TRACE_BUFFER_SIZE);
+		buffer->threadIdentifier = quint64(quintptr(QThread::currentThreadId()));
+
+		if (QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread())
+		{
+			buffer->threadName = QLatin1String("Main");
+		}
+		else
+		{
+			buffer->threadName = QThread::currentThread()->objectName();
+		}
+
+		traceBuffers.setLocalData(buffer);
+
+		QMutexLocker locker(&m_buffersMutex);
+
+		m_buffers.append(buffer);
+	}
+
+	return traceBuffers.localData().data();
+}
+
+qint64 Tracer::getTimestamp()
+{
+	return (m_timer.nsecsElapsed() / 1000);
+}
+
+bool Tracer::save()
+{
+	if (!isEnabled())
+	{
+		return false;
+	}
+
+	const qint64 processIdentifier(QCoreApplication::applicationPid());
+	QJsonArray events;
+	QMutexLocker buffersLocker(&m_buffersMutex);
+
+	for (int i = 0; i < m_buffers.count(); ++i)
+	{
+		TraceBuffer *buffer(m_buffers.at(i).data());
+		QMutexLocker bufferLocker(&buffer->mutex);
+
+		if (!buffer->threadName.isEmpty())
+		{
+			events.append(QJsonObject({{QLatin1String("name"), QLatin1String("thread_name")}, {QLatin1String("ph"), QLatin1String("M")}, {QLatin1String("pid"), processIdentifier}, {QLatin1String("tid"), qint64(buffer->threadIdentifier)}, {QLatin1String("args"), QJsonObject({{QLatin1String("name"), buffer->threadName}})}}));
+		}
+
+		const int amount(buffer->isFull ? buffer->events.count() : buffer->position);
+		const int offset(buffer->isFull ? buffer->position : 0);
+
+		for (int j = 0; j < amount; ++j)
+		{
+			const TraceEvent &event(buffer->events.at((offset + j) % buffer->events.count()));
+
+			events.append(QJsonObject({{QLatin1String("name"), QString::fromLatin1(event.name)}, {QLatin1String("cat"), QString::fromLatin1(event.category)}, {QLatin1String("ph"), QLatin1String("X")}, {QLatin1String("ts"), event.start}, {QLatin1String("dur"), event.duration}, {QLatin1String("pid"), processIdentifier}, {QLatin1String("tid"), qint64(buffer->threadIdentifier)}}));
+		}
+	}
+
+	buffersLocker.unlock();
+
+	QSaveFile file(m_path);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	file.write(QJsonDocument(QJsonObject({{QLatin1String("traceEvents"), events}, {QLatin1String("displayTimeUnit"), QLatin1String("ms")}})).toJson(QJsonDocument::Compact));
+
+	return file.commit();
+}
+
+}
@@ -0,0 +1,110 @@
+/**************************************************************************
+* Meerkat Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2016 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef MEERKAT_TRACER_H
+#define MEERKAT_TRACER_H
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#ifdef MEERKAT_ENABLE_TRACING
+#define MEERKAT_TRACE_CONCATENATE_INTERNAL(first, second) first##second
+#define MEERKAT_TRACE_CONCATENATE(first, second) MEERKAT_TRACE_CONCATENATE_INTERNAL(first, second)
+#define MEERKAT_TRACE_SCOPE(category, name) const Meerkat::TraceScope MEERKAT_TRACE_CONCATENATE(traceScope, __LINE__)(category, name)
+#define MEERKAT_TRACE_FUNCTION(category) MEERKAT_TRACE_SCOPE(category, Q_FUNC_INFO)
+#else
+#define MEERKAT_TRACE_SCOPE(category, name)
+#define MEERKAT_TRACE_FUNCTION(category)
+#endif
+
+namespace Meerkat
+{
+
+class Tracer
+{
+public:
+	struct TraceEvent
+	{
+		const char *category = nullptr;
+		const char *name = nullptr;
+		qint64 start = 0;
+		qint64 duration = 0;
+	};
+
+	struct TraceBuffer
+	{
+		QMutex mutex;
+		QVector<TraceEvent> events;
+		QString threadName;
+		quint64 threadIdentifier = 0;
+		int position = 0;
+		bool isFull = false;
+	};
+
+	static void start(const QString &path);
+	static void addEvent(const char *category, const char *name, qint64 start, qint64 duration);
+	static bool save();
+	static qint64 getTimestamp();
+
+	static inline bool isEnabled()
+	{
+		return (m_isEnabled.load() != 0);
+	}
+
+protected:
+	static TraceBuffer* getBuffer();
+
+private:
+	static QString m_path;
+	static QElapsedTimer m_timer;
+	static QMutex m_buffersMutex;
+	static QVector<QSharedPointer<TraceBuffer> > m_buffers;
+	static QAtomicInt m_isEnabled;
+};
+
+class TraceScope
+{
+public:
+	inline TraceScope(const char *category, const char *name) : m_category(category),
+		m_name(name),
+		m_start(Tracer::isEnabled() ? Tracer::getTimestamp() : -1)
+	{
+	}
+
+	inline ~TraceScope()
+	{
+		if (m_start >= 0)
+		{
+			Tracer::addEvent(m_category, m_name, m_start, (Tracer::getTimestamp() - m_start));
+		}
+	}
+
+private:
+	const char *m_category;
+	const char *m_name;
+	qint64 m_start;
+};
+
+}
+
+#endif
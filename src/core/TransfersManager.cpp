@@ -22,23 +22,37 @@
 #include "NetworkManagerFactory.h"
 #include "NotificationsManager.h"
 #include "SessionsManager.h"
+#include "Tracer.h"
 #include "Utils.h"
 #include "../ui/MainWindow.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QDir>
+#include <QtCore/QJsonDocument>
 #include <QtCore/QMimeDatabase>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSaveFile>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QTemporaryFile>
 #include <QtCore/QTimer>
 #include <QtWidgets/QMessageBox>
 
+#define TRANSFERS_LOG_COMPACTION_LIMIT 100
+#define TRANSFER_HASH_CHUNK_SIZE 1048576
+
 namespace Meerkat
 {
 
 TransfersManager* TransfersManager::m_instance(nullptr);
 QList<Transfer*> TransfersManager::m_transfers;
 QList<Transfer*> TransfersManager::m_privateTransfers;
+QSet<Transfer*> TransfersManager::m_changedTransfers;
+QHash<Transfer*, quint64> TransfersManager::m_identifiers;
+QMap<quint64, TransferRecord> TransfersManager::m_records;
+QList<quint64> TransfersManager::m_removedRecords;
+quint64 TransfersManager::m_identifierCounter(0);
+int TransfersManager::m_logEntries(0);
+bool TransfersManager::m_areRecordsLoaded(false);
 bool TransfersManager::m_isInitilized(false);
 
 Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
@@ -57,19 +71,22 @@ Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ?
 {
 }
 
-Transfer::Transfer(const QSettings &settings, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
+Transfer::Transfer(const TransferRecord &record, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
 	m_reply(nullptr),
 	m_device(nullptr),
-	m_source(settings.value(QLatin1String("source")).toUrl()),
-	m_target(settings.value(QLatin1String("target")).toString()),
-	m_timeStarted(settings.value(QLatin1String("timeStarted")).toDateTime()),
-	m_timeFinished(settings.value(QLatin1String("timeFinished")).toDateTime()),
+	m_md5Hash(record.md5Hash),
+	m_sha256Hash(record.sha256Hash),
+	m_expectedHash(record.expectedHash),
+	m_source(record.source),
+	m_target(record.target),
+	m_timeStarted(record.timeStarted),
+	m_timeFinished(record.timeFinished),
 	m_mimeType(QMimeDatabase().mimeTypeForFile(m_target)),
 	m_speed(0),
 	m_bytesStart(0),
 	m_bytesReceivedDifference(0),
-	m_bytesReceived(settings.value(QLatin1String("bytesReceived")).toLongLong()),
-	m_bytesTotal(settings.value(QLatin1String("bytesTotal")).toLongLong()),
+	m_bytesReceived(record.bytesReceived),
+	m_bytesTotal(record.bytesTotal),
 	m_options(NoOption),
 	m_state((m_bytesReceived > 0 && m_bytesTotal == m_bytesReceived) ? FinishedState : ErrorState),
 	m_updateTimer(0),
@@ -180,6 +197,20 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 	m_reply = reply;
 	m_mimeType = QMimeDatabase().mimeTypeForName(m_reply->header(QNetworkRequest::ContentTypeHeader).toString());
 
+	if (m_options.testFlag(CanNotifyOption) && m_reply->hasRawHeader(QByteArray("Digest")))
+	{
+		setExpectedHash(getDigest(m_reply));
+
+		const QString duplicate(TransfersManager::findDuplicate(m_expectedHash, m_reply->header(QNetworkRequest::ContentLengthHeader).toLongLong()));
+
+		if (!duplicate.isEmpty() && QMessageBox::question(SessionsManager::getActiveWindow(), tr("Question"), tr("This file was already downloaded:\n%1\n\nDo you want to download it again?").arg(duplicate), (QMessageBox::Yes | QMessageBox::No)) == QMessageBox::No)
+		{
+			cancel();
+
+			return;
+		}
+	}
+
 	QString temporaryFileName(getSuggestedFileName());
 
 	if (temporaryFileName.isEmpty())
@@ -213,6 +244,7 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 	m_target = m_device->fileName();
 	m_state = (m_reply->isFinished() ? FinishedState : RunningState);
 
+	resetHash();
 	downloadData();
 
 	const bool isRunning(m_state == RunningState);
@@ -326,6 +358,8 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 		else
 		{
 			m_mimeType = QMimeDatabase().mimeTypeForFile(m_target);
+
+			finalizeHash();
 		}
 	}
 }
@@ -353,10 +387,18 @@ void Transfer::downloadData()
 		if (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid() && m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
 		{
 			m_device->reset();
+
+			resetHash();
 		}
 	}
 
-	m_device->write(m_reply->readAll());
+	if (m_expectedHash.isEmpty() && m_reply->hasRawHeader(QByteArray("Digest")))
+	{
+		setExpectedHash(getDigest(m_reply));
+	}
+
+	writeData(m_reply->readAll());
+
 	m_device->seek(m_device->size());
 
 	if (m_state == RunningState && m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() && m_bytesTotal >= 0 && m_device->size() == m_bytesTotal)
@@ -402,7 +444,7 @@ void Transfer::downloadFinished()
 
 	if (m_reply->size() > 0)
 	{
-		m_device->write(m_reply->readAll());
+		writeData(m_reply->readAll());
 	}
 
 	disconnect(m_reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(downloadProgress(qint64,qint64)));
@@ -426,6 +468,8 @@ void Transfer::downloadFinished()
 
 		m_state = FinishedState;
 		m_mimeType = QMimeDatabase().mimeTypeForFile(m_target);
+
+		finalizeHash();
 	}
 
 	emit finished();
@@ -478,6 +522,96 @@ void Transfer::markFinished(bool reset)
 	m_timeFinished = (reset ? QDateTime() : QDateTime::currentDateTime());
 }
 
+void Transfer::handleHashTaskFinished()
+{
+	QFutureWatcher<HashTask> *watcher(static_cast<QFutureWatcher<HashTask>*>(sender()));
+
+	if (!watcher)
+	{
+		return;
+	}
+
+	const HashTask task(watcher->result());
+
+	watcher->deleteLater();
+
+	m_hashWatcher = nullptr;
+	m_md5Hash = task.md5Hash;
+	m_sha256Hash = task.sha256Hash;
+
+	emit changed();
+}
+
+void Transfer::writeData(const QByteArray &data)
+{
+	if (!m_device || data.isEmpty())
+	{
+		return;
+	}
+
+	m_device->write(data);
+
+	if (m_sha256Hasher)
+	{
+		HashTask task;
+		task.md5Hasher = m_md5Hasher;
+		task.sha256Hasher = m_sha256Hasher;
+		task.data = data;
+
+		QtConcurrent::run(TransfersManager::getHashThreadPool(), &Transfer::processHashTask, task);
+	}
+}
+
+void Transfer::resetHash(qint64 size)
+{
+	if (m_hashWatcher)
+	{
+		m_hashWatcher->disconnect(this);
+		m_hashWatcher->deleteLater();
+		m_hashWatcher = nullptr;
+	}
+
+	m_md5Hasher.reset(new QCryptographicHash(QCryptographicHash::Md5));
+	m_sha256Hasher.reset(new QCryptographicHash(QCryptographicHash::Sha256));
+	m_md5Hash.clear();
+	m_sha256Hash.clear();
+
+	if (size > 0)
+	{
+		HashTask task;
+		task.md5Hasher = m_md5Hasher;
+		task.sha256Hasher = m_sha256Hasher;
+		task.path = m_target;
+		task.size = size;
+
+		QtConcurrent::run(TransfersManager::getHashThreadPool(), &Transfer::processHashTask, task);
+	}
+}
+
+void Transfer::finalizeHash()
+{
+	if (!m_sha256Hasher)
+	{
+		return;
+	}
+
+	HashTask task;
+	task.md5Hasher = m_md5Hasher;
+	task.sha256Hasher = m_sha256Hasher;
+	task.needsResult = true;
+
+	m_md5Hasher.clear();
+	m_sha256Hasher.clear();
+
+	QFutureWatcher<HashTask> *watcher(new QFutureWatcher<HashTask>(this));
+
+	connect(watcher, SIGNAL(finished()), this, SLOT(handleHashTaskFinished()));
+
+	watcher->setFuture(QtConcurrent::run(TransfersManager::getHashThreadPool(), &Transfer::processHashTask, task));
+
+	m_hashWatcher = watcher;
+}
+
 void Transfer::openTarget()
 {
 	Utils::runApplication(m_openCommand, QUrl::fromLocalFile(getTarget()));
@@ -571,6 +705,25 @@ void Transfer::setOpenCommand(const QString &command)
 	}
 }
 
+bool Transfer::setExpectedHash(const QByteArray &hash)
+{
+	const QByteArray normalizedHash(hash.trimmed().toLower());
+
+	if (!normalizedHash.isEmpty() && ((normalizedHash.length() != 32 && normalizedHash.length() != 64) || QByteArray::fromHex(normalizedHash).toHex() != normalizedHash))
+	{
+		return false;
+	}
+
+	if (normalizedHash != m_expectedHash)
+	{
+		m_expectedHash = normalizedHash;
+
+		emit changed();
+	}
+
+	return true;
+}
+
 void Transfer::setUpdateInterval(int interval)
 {
 	m_updateInterval = interval;
@@ -685,6 +838,99 @@ qint64 Transfer::getBytesTotal() const
 	return m_bytesTotal;
 }
 
+QByteArray Transfer::getHash(QCryptographicHash::Algorithm algorithm) const
+{
+	switch (algorithm)
+	{
+		case QCryptographicHash::Md5:
+			return m_md5Hash;
+		case QCryptographicHash::Sha256:
+			return m_sha256Hash;
+		default:
+			break;
+	}
+
+	return QByteArray();
+}
+
+QByteArray Transfer::getExpectedHash() const
+{
+	return m_expectedHash;
+}
+
+QByteArray Transfer::getDigest(QNetworkReply *reply)
+{
+	const QList<QByteArray> digests(reply->rawHeader(QByteArray("Digest")).split(','));
+	QByteArray hash;
+
+	for (int i = 0; i < digests.count(); ++i)
+	{
+		const QByteArray digest(digests.at(i).trimmed());
+		const int separator(digest.indexOf('='));
+
+		if (separator < 0)
+		{
+			continue;
+		}
+
+		const QByteArray algorithm(digest.left(separator).toLower());
+
+		if (algorithm == QByteArray("sha-256"))
+		{
+			return QByteArray::fromBase64(digest.mid(separator + 1)).toHex();
+		}
+
+		if (algorithm == QByteArray("md5"))
+		{
+			hash = QByteArray::fromBase64(digest.mid(separator + 1)).toHex();
+		}
+	}
+
+	return hash;
+}
+
+Transfer::HashTask Transfer::processHashTask(HashTask task)
+{
+	if (!task.path.isEmpty())
+	{
+		QFile file(task.path);
+
+		if (file.open(QIODevice::ReadOnly))
+		{
+			qint64 remaining(task.size);
+
+			while (remaining > 0)
+			{
+				const QByteArray data(file.read(qMin(remaining, qint64(TRANSFER_HASH_CHUNK_SIZE))));
+
+				if (data.isEmpty())
+				{
+					break;
+				}
+
+				task.md5Hasher->addData(data);
+				task.sha256Hasher->addData(data);
+
+				remaining -= data.size();
+			}
+		}
+	}
+
+	if (!task.data.isEmpty())
+	{
+		task.md5Hasher->addData(task.data);
+		task.sha256Hasher->addData(task.data);
+	}
+
+	if (task.needsResult)
+	{
+		task.md5Hash = task.md5Hasher->result().toHex();
+		task.sha256Hash = task.sha256Hasher->result().toHex();
+	}
+
+	return task;
+}
+
 Transfer::TransferOptions Transfer::getOptions() const
 {
 	return m_options;
@@ -695,6 +941,21 @@ Transfer::TransferState Transfer::getState() const
 	return m_state;
 }
 
+Transfer::HashState Transfer::getHashState() const
+{
+	if (m_sha256Hash.isEmpty())
+	{
+		return ((m_hashWatcher || (m_sha256Hasher && m_state == RunningState)) ? ComputingHashState : UnknownHashState);
+	}
+
+	if (m_expectedHash.isEmpty())
+	{
+		return ComputedHashState;
+	}
+
+	return ((getHash((m_expectedHash.length() == 32) ? QCryptographicHash::Md5 : QCryptographicHash::Sha256) == m_expectedHash) ? ValidHashState : InvalidHashState);
+}
+
 bool Transfer::resume()
 {
 	if (m_state != ErrorState || !QFile::exists(m_target))
@@ -722,6 +983,8 @@ bool Transfer::resume()
 	m_timeFinished = QDateTime();
 	m_bytesStart = file->size();
 
+	resetHash(m_bytesStart);
+
 	QNetworkRequest request;
 	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
@@ -764,6 +1027,8 @@ bool Transfer::restart()
 	m_timeFinished = QDateTime();
 	m_bytesStart = 0;
 
+	resetHash();
+
 	QNetworkRequest request;
 	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
@@ -890,10 +1155,15 @@ bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
 TransfersManager::TransfersManager(QObject *parent) : QObject(parent),
 	m_saveTimer(0)
 {
+	m_hashThreadPool.setMaxThreadCount(1);
+
+	connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), this, SLOT(saveAll()));
 }
 
 void TransfersManager::createInstance(QObject *parent)
 {
+	MEERKAT_TRACE_FUNCTION("startup");
+
 	if (!m_instance)
 	{
 		m_instance = new TransfersManager(parent);
@@ -912,8 +1182,13 @@ void TransfersManager::timerEvent(QTimerEvent *event)
 	}
 }
 
-void TransfersManager::scheduleSave()
+void TransfersManager::scheduleSave(Transfer *transfer)
 {
+	if (transfer && !transfer->getOptions().testFlag(Transfer::IsPrivateOption))
+	{
+		m_changedTransfers.insert(transfer);
+	}
+
 	if (m_saveTimer == 0)
 	{
 		m_saveTimer = startTimer(1000);
@@ -945,39 +1220,260 @@ void TransfersManager::addTransfer(Transfer *transfer)
 	{
 		m_privateTransfers.append(transfer);
 	}
+	else if (!m_identifiers.contains(transfer))
+	{
+		m_instance->scheduleSave(transfer);
+	}
 }
 
 void TransfersManager::save()
 {
-	if (SessionsManager::isReadOnly() || SettingsManager::getValue(SettingsManager::Browser_PrivateModeOption).toBool() || !SettingsManager::getValue(SettingsManager::History_RememberDownloadsOption).toBool())
+	if (!canSave())
 	{
+		m_changedTransfers.clear();
+		m_removedRecords.clear();
+
 		return;
 	}
 
-	QSettings history(SessionsManager::getWritableDataPath(QLatin1String("transfers.ini")), QSettings::IniFormat);
-	history.clear();
+	loadRecords();
 
 	const int limit(SettingsManager::getValue(SettingsManager::History_DownloadsLimitPeriodOption).toInt());
-	int entry(1);
+	QList<QJsonObject> objects;
 
 	for (int i = 0; i < m_transfers.count(); ++i)
 	{
-		if (m_privateTransfers.contains(m_transfers.at(i)) || (m_transfers.at(i)->getState() == Transfer::FinishedState && m_transfers.at(i)->getTimeFinished().isValid() && m_transfers.at(i)->getTimeFinished().daysTo(QDateTime::currentDateTime()) > limit))
+		Transfer *transfer(m_transfers.at(i));
+
+		if (!m_changedTransfers.contains(transfer) || m_privateTransfers.contains(transfer))
+		{
+			continue;
+		}
+
+		if (transfer->getState() == Transfer::FinishedState && transfer->getTimeFinished().isValid() && transfer->getTimeFinished().daysTo(QDateTime::currentDateTime()) > limit)
+		{
+			if (m_identifiers.contains(transfer))
+			{
+				m_removedRecords.append(m_identifiers.take(transfer));
+			}
+
+			continue;
+		}
+
+		if (!m_identifiers.contains(transfer))
+		{
+			++m_identifierCounter;
+
+			m_identifiers[transfer] = m_identifierCounter;
+		}
+
+		const quint64 identifier(m_identifiers[transfer]);
+		const TransferRecord record(getRecord(transfer));
+
+		m_records[identifier] = record;
+
+		objects.append(getRecordObject(identifier, record));
+	}
+
+	for (int i = 0; i < m_removedRecords.count(); ++i)
+	{
+		m_records.remove(m_removedRecords.at(i));
+
+		objects.append(QJsonObject({{QLatin1String("identifier"), qint64(m_removedRecords.at(i))}, {QLatin1String("removed"), true}}));
+	}
+
+	m_changedTransfers.clear();
+	m_removedRecords.clear();
+
+	if (m_logEntries + objects.count() > qMax(TRANSFERS_LOG_COMPACTION_LIMIT, (m_records.count() * 2)))
+	{
+		compactRecords();
+	}
+	else
+	{
+		appendRecords(objects);
+	}
+}
+
+void TransfersManager::saveAll()
+{
+	for (int i = 0; i < m_transfers.count(); ++i)
+	{
+		if (m_transfers.at(i)->getState() == Transfer::RunningState || !m_identifiers.contains(m_transfers.at(i)))
+		{
+			scheduleSave(m_transfers.at(i));
+		}
+	}
+
+	save();
+}
+
+void TransfersManager::loadRecords()
+{
+	if (m_areRecordsLoaded)
+	{
+		return;
+	}
+
+	m_areRecordsLoaded = true;
+
+	const QString legacyPath(SessionsManager::getWritableDataPath(QLatin1String("transfers.ini")));
+	QFile file(SessionsManager::getWritableDataPath(QLatin1String("transfers.log")));
+
+	if (!file.exists() && QFile::exists(legacyPath))
+	{
+		QSettings history(legacyPath, QSettings::IniFormat);
+		const QStringList entries(history.childGroups());
+
+		for (int i = 0; i < entries.count(); ++i)
+		{
+			history.beginGroup(entries.at(i));
+
+			if (!history.value(QLatin1String("source")).toString().isEmpty() && !history.value(QLatin1String("target")).toString().isEmpty())
+			{
+				TransferRecord record;
+				record.source = history.value(QLatin1String("source")).toUrl();
+				record.target = history.value(QLatin1String("target")).toString();
+				record.timeStarted = history.value(QLatin1String("timeStarted")).toDateTime();
+				record.timeFinished = history.value(QLatin1String("timeFinished")).toDateTime();
+				record.bytesReceived = history.value(QLatin1String("bytesReceived")).toLongLong();
+				record.bytesTotal = history.value(QLatin1String("bytesTotal")).toLongLong();
+
+				++m_identifierCounter;
+
+				m_records[m_identifierCounter] = record;
+			}
+
+			history.endGroup();
+		}
+
+		if (compactRecords())
+		{
+			QFile::remove(legacyPath);
+		}
+
+		return;
+	}
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return;
+	}
+
+	while (!file.atEnd())
+	{
+		const QJsonObject object(QJsonDocument::fromJson(file.readLine()).object());
+		const quint64 identifier(object.value(QLatin1String("identifier")).toVariant().toULongLong());
+
+		if (identifier == 0)
+		{
+			continue;
+		}
+
+		++m_logEntries;
+
+		m_identifierCounter = qMax(m_identifierCounter, identifier);
+
+		if (object.value(QLatin1String("removed")).toBool())
 		{
+			m_records.remove(identifier);
+
 			continue;
 		}
 
-		history.setValue(QStringLiteral("%1/source").arg(entry), m_transfers.at(i)->getSource().toString());
-		history.setValue(QStringLiteral("%1/target").arg(entry), m_transfers.at(i)->getTarget());
-		history.setValue(QStringLiteral("%1/timeStarted").arg(entry), m_transfers.at(i)->getTimeStarted().toString(Qt::ISODate));
-		history.setValue(QStringLiteral("%1/timeFinished").arg(entry), ((m_transfers.at(i)->getTimeFinished().isValid() && m_transfers.at(i)->getState() != Transfer::RunningState) ? m_transfers.at(i)->getTimeFinished() : QDateTime::currentDateTime()).toString(Qt::ISODate));
-		history.setValue(QStringLiteral("%1/bytesTotal").arg(entry), m_transfers.at(i)->getBytesTotal());
-		history.setValue(QStringLiteral("%1/bytesReceived").arg(entry), m_transfers.at(i)->getBytesReceived());
+		TransferRecord record;
+		record.source = QUrl(object.value(QLatin1String("source")).toString());
+		record.target = object.value(QLatin1String("target")).toString();
+		record.timeStarted = QDateTime::fromString(object.value(QLatin1String("timeStarted")).toString(), Qt::ISODate);
+		record.timeFinished = QDateTime::fromString(object.value(QLatin1String("timeFinished")).toString(), Qt::ISODate);
+		record.md5Hash = object.value(QLatin1String("md5")).toString().toLatin1();
+		record.sha256Hash = object.value(QLatin1String("sha256")).toString().toLatin1();
+		record.expectedHash = object.value(QLatin1String("expectedHash")).toString().toLatin1();
+		record.bytesReceived = object.value(QLatin1String("bytesReceived")).toVariant().toLongLong();
+		record.bytesTotal = object.value(QLatin1String("bytesTotal")).toVariant().toLongLong();
+
+		m_records[identifier] = record;
+	}
+
+	file.close();
+
+	const int limit(SettingsManager::getValue(SettingsManager::History_DownloadsLimitPeriodOption).toInt());
+	bool needsCompaction(m_logEntries > qMax(TRANSFERS_LOG_COMPACTION_LIMIT, (m_records.count() * 2)));
+	QMap<quint64, TransferRecord>::iterator iterator(m_records.begin());
+
+	while (iterator != m_records.end())
+	{
+		const TransferRecord &record(iterator.value());
+
+		if (record.bytesReceived > 0 && record.bytesReceived == record.bytesTotal && record.timeFinished.isValid() && record.timeFinished.daysTo(QDateTime::currentDateTime()) > limit)
+		{
+			iterator = m_records.erase(iterator);
+
+			needsCompaction = true;
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+
+	if (needsCompaction)
+	{
+		compactRecords();
+	}
+}
+
+void TransfersManager::appendRecords(const QList<QJsonObject> &objects)
+{
+	if (objects.isEmpty() || !canSave())
+	{
+		return;
+	}
+
+	QFile file(SessionsManager::getWritableDataPath(QLatin1String("transfers.log")));
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+	{
+		return;
+	}
+
+	for (int i = 0; i < objects.count(); ++i)
+	{
+		file.write(QJsonDocument(objects.at(i)).toJson(QJsonDocument::Compact) + '\n');
+	}
+
+	m_logEntries += objects.count();
+}
+
+bool TransfersManager::compactRecords()
+{
+	if (!canSave())
+	{
+		return false;
+	}
+
+	QSaveFile file(SessionsManager::getWritableDataPath(QLatin1String("transfers.log")));
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	QMap<quint64, TransferRecord>::const_iterator iterator;
+
+	for (iterator = m_records.constBegin(); iterator != m_records.constEnd(); ++iterator)
+	{
+		file.write(QJsonDocument(getRecordObject(iterator.key(), iterator.value())).toJson(QJsonDocument::Compact) + '\n');
+	}
 
-		++entry;
+	if (!file.commit())
+	{
+		return false;
 	}
 
-	history.sync();
+	m_logEntries = m_records.count();
+
+	return true;
 }
 
 void TransfersManager::transferStarted()
@@ -988,7 +1484,7 @@ void TransfersManager::transferStarted()
 	{
 		emit transferStarted(transfer);
 
-		scheduleSave();
+		scheduleSave(transfer);
 	}
 }
 
@@ -1007,7 +1503,7 @@ void TransfersManager::transferFinished()
 
 		if (!m_privateTransfers.contains(transfer))
 		{
-			scheduleSave();
+			scheduleSave(transfer);
 		}
 	}
 }
@@ -1020,7 +1516,10 @@ void TransfersManager::transferChanged()
 	{
 		emit transferChanged(transfer);
 
-		scheduleSave();
+		if (transfer->getState() != Transfer::RunningState)
+		{
+			scheduleSave(transfer);
+		}
 	}
 }
 
@@ -1032,7 +1531,7 @@ void TransfersManager::transferStopped()
 	{
 		emit transferStopped(transfer);
 
-		scheduleSave();
+		scheduleSave(transfer);
 	}
 }
 
@@ -1045,6 +1544,37 @@ void TransfersManager::clearTransfers(int period)
 			TransfersManager::removeTransfer(m_transfers.at(i));
 		}
 	}
+
+	if (m_isInitilized)
+	{
+		return;
+	}
+
+	loadRecords();
+
+	const QSet<quint64> identifiers(m_identifiers.values().toSet());
+	QMap<quint64, TransferRecord>::iterator iterator(m_records.begin());
+
+	while (iterator != m_records.end())
+	{
+		const TransferRecord &record(iterator.value());
+
+		if (!identifiers.contains(iterator.key()) && record.bytesReceived > 0 && record.bytesReceived == record.bytesTotal && (period == 0 || (record.timeFinished.isValid() && record.timeFinished.secsTo(QDateTime::currentDateTime()) > (period * 3600))))
+		{
+			m_removedRecords.append(iterator.key());
+
+			iterator = m_records.erase(iterator);
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+
+	if (!m_removedRecords.isEmpty())
+	{
+		m_instance->scheduleSave(nullptr);
+	}
 }
 
 TransfersManager* TransfersManager::getInstance()
@@ -1052,6 +1582,11 @@ TransfersManager* TransfersManager::getInstance()
 	return m_instance;
 }
 
+QThreadPool* TransfersManager::getHashThreadPool()
+{
+	return (m_instance ? &m_instance->m_hashThreadPool : QThreadPool::globalInstance());
+}
+
 Transfer* TransfersManager::startTransfer(const QUrl &source, const QString &target, Transfer::TransferOptions options)
 {
 	Transfer *transfer(new Transfer(source, target, options, m_instance));
@@ -1100,33 +1635,111 @@ Transfer* TransfersManager::startTransfer(QNetworkReply *reply, const QString &t
 	return transfer;
 }
 
-QList<Transfer*> TransfersManager::getTransfers()
+TransferRecord TransfersManager::getRecord(Transfer *transfer)
+{
+	TransferRecord record;
+	record.source = transfer->getSource();
+	record.target = transfer->getTarget();
+	record.timeStarted = transfer->getTimeStarted();
+	record.timeFinished = ((transfer->getTimeFinished().isValid() && transfer->getState() != Transfer::RunningState) ? transfer->getTimeFinished() : QDateTime::currentDateTime());
+	record.md5Hash = transfer->getHash(QCryptographicHash::Md5);
+	record.sha256Hash = transfer->getHash(QCryptographicHash::Sha256);
+	record.expectedHash = transfer->getExpectedHash();
+	record.bytesReceived = transfer->getBytesReceived();
+	record.bytesTotal = transfer->getBytesTotal();
+
+	return record;
+}
+
+QJsonObject TransfersManager::getRecordObject(quint64 identifier, const TransferRecord &record)
 {
-	if (!m_isInitilized)
+	QJsonObject object({{QLatin1String("identifier"), qint64(identifier)}, {QLatin1String("source"), record.source.toString()}, {QLatin1String("target"), record.target}, {QLatin1String("timeStarted"), record.timeStarted.toString(Qt::ISODate)}, {QLatin1String("timeFinished"), record.timeFinished.toString(Qt::ISODate)}, {QLatin1String("bytesReceived"), record.bytesReceived}, {QLatin1String("bytesTotal"), record.bytesTotal}});
+
+	if (!record.md5Hash.isEmpty())
 	{
-		QSettings history(SessionsManager::getWritableDataPath(QLatin1String("transfers.ini")), QSettings::IniFormat);
-		const QStringList entries(history.childGroups());
+		object.insert(QLatin1String("md5"), QString::fromLatin1(record.md5Hash));
+	}
 
-		m_transfers.reserve(entries.count());
+	if (!record.sha256Hash.isEmpty())
+	{
+		object.insert(QLatin1String("sha256"), QString::fromLatin1(record.sha256Hash));
+	}
 
-		for (int i = 0; i < entries.count(); ++i)
-		{
-			history.beginGroup(entries.at(i));
+	if (!record.expectedHash.isEmpty())
+	{
+		object.insert(QLatin1String("expectedHash"), QString::fromLatin1(record.expectedHash));
+	}
 
-			if (!history.value(QLatin1String("source")).toString().isEmpty() && !history.value(QLatin1String("target")).toString().isEmpty())
+	return object;
+}
+
+QList<Transfer*> TransfersManager::getTransfers(bool includeHistory)
+{
+	if (includeHistory && !m_isInitilized)
+	{
+		m_isInitilized = true;
+
+		loadRecords();
+
+		const QList<Transfer*> transfers(m_transfers);
+		const QSet<quint64> identifiers(m_identifiers.values().toSet());
+		QMap<quint64, TransferRecord>::const_iterator iterator;
+
+		m_transfers.clear();
+		m_transfers.reserve(m_records.count() + transfers.count());
+
+		for (iterator = m_records.constBegin(); iterator != m_records.constEnd(); ++iterator)
+		{
+			if (!identifiers.contains(iterator.key()) && !iterator.value().source.isEmpty() && !iterator.value().target.isEmpty())
 			{
-				addTransfer(new Transfer(history, m_instance));
+				Transfer *transfer(new Transfer(iterator.value(), m_instance));
+
+				m_identifiers[transfer] = iterator.key();
+
+				addTransfer(transfer);
 			}
+		}
 
-			history.endGroup();
+		m_transfers.append(transfers);
+	}
+
+	return m_transfers;
+}
+
+QString TransfersManager::findDuplicate(const QByteArray &hash, qint64 size, const QString &excludedTarget)
+{
+	if (hash.isEmpty() || size <= 0)
+	{
+		return QString();
+	}
+
+	const QCryptographicHash::Algorithm algorithm((hash.length() == 32) ? QCryptographicHash::Md5 : QCryptographicHash::Sha256);
+
+	for (int i = 0; i < m_transfers.count(); ++i)
+	{
+		Transfer *transfer(m_transfers.at(i));
+
+		if (!transfer->getOptions().testFlag(Transfer::IsPrivateOption) && transfer->getState() == Transfer::FinishedState && transfer->getBytesTotal() == size && transfer->getTarget() != excludedTarget && transfer->getHash(algorithm) == hash && QFileInfo(transfer->getTarget()).size() == size)
+		{
+			return transfer->getTarget();
 		}
+	}
 
-		m_isInitilized = true;
+	loadRecords();
+
+	QMap<quint64, TransferRecord>::const_iterator iterator;
+
+	for (iterator = m_records.constBegin(); iterator != m_records.constEnd(); ++iterator)
+	{
+		const TransferRecord &record(iterator.value());
 
-		connect(QCoreApplication::instance(), SIGNAL(aboutToQuit()), m_instance, SLOT(save()));
+		if (record.bytesReceived == size && record.bytesTotal == size && record.target != excludedTarget && ((algorithm == QCryptographicHash::Md5) ? record.md5Hash : record.sha256Hash) == hash && QFileInfo(record.target).size() == size)
+		{
+			return record.target;
+		}
 	}
 
-	return m_transfers;
+	return QString();
 }
 
 bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
@@ -1139,6 +1752,14 @@ bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 	m_transfers.removeAll(transfer);
 
 	m_privateTransfers.removeAll(transfer);
+	m_changedTransfers.remove(transfer);
+
+	if (m_identifiers.contains(transfer))
+	{
+		m_removedRecords.append(m_identifiers.take(transfer));
+
+		m_instance->scheduleSave(nullptr);
+	}
 
 	if (transfer->getState() == Transfer::RunningState)
 	{
@@ -1157,6 +1778,11 @@ bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 	return true;
 }
 
+bool TransfersManager::canSave()
+{
+	return (!SessionsManager::isReadOnly() && !SettingsManager::getValue(SettingsManager::Browser_PrivateModeOption).toBool() && SettingsManager::getValue(SettingsManager::History_RememberDownloadsOption).toBool());
+}
+
 bool TransfersManager::isDownloading(const QString &source, const QString &target)
 {
 	if (source.isEmpty() && target.isEmpty())
@@ -20,10 +20,17 @@
 #ifndef MEERKAT_TRANSFERSMANAGER_H
 #define MEERKAT_TRANSFERSMANAGER_H
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
 #include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
 #include <QtCore/QMimeType>
 #include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtCore/QSettings>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QNetworkReply>
 
 namespace Meerkat
@@ -31,6 +38,19 @@ namespace Meerkat
 
 class NetworkManager;
 
+struct TransferRecord
+{
+	QUrl source;
+	QString target;
+	QDateTime timeStarted;
+	QDateTime timeFinished;
+	QByteArray md5Hash;
+	QByteArray sha256Hash;
+	QByteArray expectedHash;
+	qint64 bytesReceived = 0;
+	qint64 bytesTotal = 0;
+};
+
 class Transfer : public QObject
 {
 	Q_OBJECT
@@ -59,8 +79,29 @@ public:
 		CancelledState = 4
 	};
 
+	enum HashState
+	{
+		UnknownHashState = 0,
+		ComputingHashState = 1,
+		ComputedHashState = 2,
+		ValidHashState = 3,
+		InvalidHashState = 4
+	};
+
+	struct HashTask
+	{
+		QSharedPointer<QCryptographicHash> md5Hasher;
+		QSharedPointer<QCryptographicHash> sha256Hasher;
+		QByteArray data;
+		QByteArray md5Hash;
+		QByteArray sha256Hash;
+		QString path;
+		qint64 size = 0;
+		bool needsResult = false;
+	};
+
 	explicit Transfer(TransferOptions options = CanAskForPathOption, QObject *parent = nullptr);
-	Transfer(const QSettings &settings, QObject *parent = nullptr);
+	Transfer(const TransferRecord &record, QObject *parent = nullptr);
 	Transfer(const QUrl &source, const QString &target = QString(), TransferOptions options = CanAskForPathOption, QObject *parent = nullptr);
 	Transfer(const QNetworkRequest &request, const QString &target = QString(), TransferOptions options = CanAskForPathOption, QObject *parent = nullptr);
 	Transfer(QNetworkReply *reply, const QString &target = QString(), TransferOptions options = CanAskForPathOption, QObject *parent = nullptr);
@@ -76,8 +117,11 @@ public:
 	virtual qint64 getSpeed() const;
 	virtual qint64 getBytesReceived() const;
 	virtual qint64 getBytesTotal() const;
+	virtual QByteArray getHash(QCryptographicHash::Algorithm algorithm) const;
+	QByteArray getExpectedHash() const;
 	TransferOptions getOptions() const;
 	virtual TransferState getState() const;
+	HashState getHashState() const;
 
 public slots:
 	void openTarget();
@@ -87,10 +131,16 @@ public slots:
 	virtual bool resume();
 	virtual bool restart();
 	virtual bool setTarget(const QString &target, bool canOverwriteExisting = false);
+	bool setExpectedHash(const QByteArray &hash);
 
 protected:
 	void timerEvent(QTimerEvent *event);
 	void start(QNetworkReply *reply, const QString &target);
+	void writeData(const QByteArray &data);
+	void resetHash(qint64 size = 0);
+	void finalizeHash();
+	static HashTask processHashTask(HashTask task);
+	static QByteArray getDigest(QNetworkReply *reply);
 
 protected slots:
 	void downloadProgress(qint64 bytesReceived, qint64 bytesTotal);
@@ -99,10 +149,17 @@ protected slots:
 	void downloadError(QNetworkReply::NetworkError error);
 	void markStarted();
 	void markFinished(bool reset = false);
+	void handleHashTaskFinished();
 
 private:
 	QPointer<QNetworkReply> m_reply;
 	QPointer<QFile> m_device;
+	QPointer<QFutureWatcher<HashTask> > m_hashWatcher;
+	QSharedPointer<QCryptographicHash> m_md5Hasher;
+	QSharedPointer<QCryptographicHash> m_sha256Hasher;
+	QByteArray m_md5Hash;
+	QByteArray m_sha256Hash;
+	QByteArray m_expectedHash;
 	QUrl m_source;
 	QString m_target;
 	QString m_openCommand;
@@ -138,10 +195,12 @@ public:
 	static void addTransfer(Transfer *transfer);
 	static void clearTransfers(int period = 0);
 	static TransfersManager* getInstance();
+	static QThreadPool* getHashThreadPool();
 	static Transfer* startTransfer(const QUrl &source, const QString &target = QString(), Transfer::TransferOptions options = Transfer::CanAskForPathOption);
 	static Transfer* startTransfer(const QNetworkRequest &request, const QString &target = QString(), Transfer::TransferOptions options = Transfer::CanAskForPathOption);
 	static Transfer* startTransfer(QNetworkReply *reply, const QString &target = QString(), Transfer::TransferOptions options = Transfer::CanAskForPathOption);
-	static QList<Transfer*> getTransfers();
+	static QList<Transfer*> getTransfers(bool includeHistory = false);
+	static QString findDuplicate(const QByteArray &hash, qint64 size, const QString &excludedTarget = QString());
 	static bool removeTransfer(Transfer *transfer, bool keepFile = true);
 	static bool isDownloading(const QString &source, const QString &target = QString());
 
@@ -149,21 +208,36 @@ protected:
 	explicit TransfersManager(QObject *parent = nullptr);
 
 	void timerEvent(QTimerEvent *event);
-	void scheduleSave();
+	void scheduleSave(Transfer *transfer);
+	static void loadRecords();
+	static void appendRecords(const QList<QJsonObject> &objects);
+	static TransferRecord getRecord(Transfer *transfer);
+	static QJsonObject getRecordObject(quint64 identifier, const TransferRecord &record);
+	static bool compactRecords();
+	static bool canSave();
 
 protected slots:
 	void save();
+	void saveAll();
 	void transferStarted();
 	void transferFinished();
 	void transferChanged();
 	void transferStopped();
 
 private:
+	QThreadPool m_hashThreadPool;
 	int m_saveTimer;
 
 	static TransfersManager *m_instance;
 	static QList<Transfer*> m_transfers;
 	static QList<Transfer*> m_privateTransfers;
+	static QSet<Transfer*> m_changedTransfers;
+	static QHash<Transfer*, quint64> m_identifiers;
+	static QMap<quint64, TransferRecord> m_records;
+	static QList<quint64> m_removedRecords;
+	static quint64 m_identifierCounter;
+	static int m_logEntries;
+	static bool m_areRecordsLoaded;
 	static bool m_isInitilized;
 
 signals:
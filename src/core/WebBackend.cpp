@@ -31,6 +31,11 @@ QUrl WebBackend::getUpdateUrl() const
 	return QUrl();
 }
 
+QString WebBackend::getReport() const
+{
+	return QString();
+}
+
 QList<SpellCheckManager::DictionaryInformation> WebBackend::getDictionaries() const
 {
 	return QList<SpellCheckManager::DictionaryInformation>();
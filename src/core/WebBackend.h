@@ -40,13 +40,14 @@ public:
 	virtual QString getEngineVersion() const = 0;
 	virtual QString getSslVersion() const = 0;
 	virtual QString getUserAgent(const QString &pattern = QString()) const = 0;
+	virtual QString getReport() const;
 	QUrl getUpdateUrl() const;
 	virtual QList<SpellCheckManager::DictionaryInformation> getDictionaries() const;
 	AddonType getType() const;
-	virtual bool requestThumbnail(const QUrl &url, const QSize &size) = 0;
+	virtual bool requestThumbnail(const QUrl &url, const QSize &size, bool hasPriority = false) = 0;
 
 signals:
-	void thumbnailAvailable(const QUrl &url, const QPixmap &thumbnail, const QString &title);
+	void thumbnailAvailable(const QUrl &url, const QImage &thumbnail, const QString &title);
 };
 
 }
@@ -123,11 +123,11 @@ int main(int argc, char *argv[])
 	const QString startupBehavior(SettingsManager::getValue(SettingsManager::Browser_StartupBehaviorOption).toString());
 	const bool isPrivate(application.getCommandLineParser()->isSet(QLatin1String("privatesession")));
 
-	if (!application.getCommandLineParser()->value(QLatin1String("session")).isEmpty() && SessionsManager::getSession(session).isClean)
+	if (!application.getCommandLineParser()->value(QLatin1String("session")).isEmpty() && SessionsManager::getSessionSummary(session).isClean)
 	{
 		SessionsManager::restoreSession(SessionsManager::getSession(session), nullptr, isPrivate);
 	}
-	else if (startupBehavior == QLatin1String("showDialog") || application.getCommandLineParser()->isSet(QLatin1String("sessionchooser")) || !SessionsManager::getSession(session).isClean)
+	else if (startupBehavior == QLatin1String("showDialog") || application.getCommandLineParser()->isSet(QLatin1String("sessionchooser")) || !SessionsManager::getSessionSummary(session).isClean)
 	{
 		StartupDialog dialog(session);
 
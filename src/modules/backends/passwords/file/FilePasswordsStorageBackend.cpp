@@ -21,16 +21,20 @@
 #include "../../../../core/Console.h"
 #include "../../../../core/SessionsManager.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
 
 namespace Meerkat
 {
 
 FilePasswordsStorageBackend::FilePasswordsStorageBackend(QObject *parent) : PasswordsStorageBackend(parent),
-	m_isInitialized(false)
+	m_isInitialized(false),
+	m_isReadOnly(false)
 {
 }
 
@@ -38,119 +42,295 @@ void FilePasswordsStorageBackend::initialize()
 {
 	m_isInitialized = true;
 
-	QFile file(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
+	const QString legacyPath(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
+
+	if (!QFile::exists(getIndexPath()) && QFile::exists(legacyPath))
+	{
+		migrate(legacyPath);
+
+		return;
+	}
+
+	QFile file(getIndexPath());
+
+	if (!file.exists())
+	{
+		return;
+	}
 
 	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
 	{
-		Console::addMessage(tr("Failed to open passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+		Console::addMessage(tr("Failed to open passwords index file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		rebuildIndex();
 
 		return;
 	}
 
-	QHash<QString, QList<PasswordsManager::PasswordInformation> > passwords;
-	QJsonObject hostsObject(QJsonDocument::fromJson(file.readAll()).object());
-	QJsonObject::const_iterator hostsIterator;
+	QJsonParseError error;
+	const QJsonDocument document(QJsonDocument::fromJson(file.readAll(), &error));
 
-	for (hostsIterator = hostsObject.constBegin(); hostsIterator != hostsObject.constEnd(); ++hostsIterator)
+	file.close();
+
+	if (error.error != QJsonParseError::NoError || !document.isArray())
+	{
+		Console::addMessage(tr("Failed to parse passwords index file: %1").arg(error.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		rebuildIndex();
+
+		return;
+	}
+
+	const QJsonArray hostsArray(document.array());
+
+	for (int i = 0; i < hostsArray.count(); ++i)
 	{
-		const QJsonArray hostArray(hostsIterator.value().toArray());
-		QList<PasswordsManager::PasswordInformation> hostPasswords;
+		m_hosts.insert(hostsArray.at(i).toString());
+	}
+
+	emit passwordsModified();
+}
+
+void FilePasswordsStorageBackend::rebuildIndex()
+{
+	const QFileInfoList entries(QDir(getStoragePath()).entryInfoList(QStringList(QLatin1String("*.json")), QDir::Files));
+	bool isSuccessful(true);
 
-		for (int i = 0; i < hostArray.count(); ++i)
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		if (entries.at(i).fileName() == QLatin1String("index.json"))
 		{
-			const QJsonObject passwordObject(hostArray.at(i).toObject());
-			PasswordsManager::PasswordInformation password;
-			password.url = QUrl(passwordObject.value(QLatin1String("url")).toString());
-			password.timeAdded = QDateTime::fromString(passwordObject.value(QLatin1String("timeAdded")).toString(), Qt::ISODate);
-			password.timeUsed = QDateTime::fromString(passwordObject.value(QLatin1String("timeUsed")).toString(), Qt::ISODate);
-			password.type = ((passwordObject.value(QLatin1String("type")).toString() == QLatin1String("auth")) ? PasswordsManager::AuthPassword : PasswordsManager::FormPassword);
+			continue;
+		}
 
-			const QJsonArray fieldsArray(passwordObject.value(QLatin1String("fields")).toArray());
+		QFile file(entries.at(i).absoluteFilePath());
 
-			for (int j = 0; j < fieldsArray.count(); ++j)
-			{
-				const QJsonObject fieldObject(fieldsArray.at(j).toObject());
-				PasswordsManager::FieldInformation field;
-				field.name = fieldObject.value(fieldObject.contains(QLatin1String("name")) ? QLatin1String("name") : QLatin1String("key")).toString();
-				field.value = fieldObject.value(QLatin1String("value")).toString();
-				field.type = ((fieldObject.value(QLatin1String("type")).toString() == QLatin1String("password")) ? PasswordsManager::PasswordField : PasswordsManager::TextField);
+		if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			isSuccessful = false;
 
-				password.fields.append(field);
-			}
+			continue;
+		}
+
+		QJsonParseError error;
+		const QJsonDocument document(QJsonDocument::fromJson(file.readAll(), &error));
 
-			hostPasswords.append(password);
+		file.close();
+
+		if (error.error != QJsonParseError::NoError || !document.isArray())
+		{
+			isSuccessful = false;
+
+			continue;
+		}
+
+		const QList<PasswordsManager::PasswordInformation> passwords(readPasswords(document.array()));
+
+		if (passwords.isEmpty())
+		{
+			continue;
 		}
 
-		passwords[hostsIterator.key()] = hostPasswords;
+		const QString host(getHost(passwords.first().url));
+
+		if (QFileInfo(getHostPath(host)).fileName() != entries.at(i).fileName())
+		{
+			isSuccessful = false;
+
+			continue;
+		}
+
+		m_hosts.insert(host);
+		m_passwords[host] = passwords;
 	}
 
-	m_passwords = passwords;
+	if (isSuccessful && saveIndex())
+	{
+		Console::addMessage(tr("Rebuilt passwords index file from stored passwords"), Console::OtherCategory, Console::WarningLevel, getIndexPath());
+	}
+	else
+	{
+		m_isReadOnly = true;
+
+		Console::addMessage(tr("Failed to rebuild passwords index file, passwords will not be saved"), Console::OtherCategory, Console::ErrorLevel, getIndexPath());
+	}
 
 	emit passwordsModified();
 }
 
-void FilePasswordsStorageBackend::save()
+void FilePasswordsStorageBackend::migrate(const QString &path)
 {
-	QFile file(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
+	QFile file(path);
 
-	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
 	{
-		Console::addMessage(tr("Failed to save passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+		Console::addMessage(tr("Failed to open passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
 
 		return;
 	}
 
-	QJsonObject hostsObject;
-	QHash<QString, QList<PasswordsManager::PasswordInformation> >::iterator hostsIterator;
+	QJsonParseError error;
+	const QJsonDocument document(QJsonDocument::fromJson(file.readAll(), &error));
+
+	file.close();
 
-	for (hostsIterator = m_passwords.begin(); hostsIterator != m_passwords.end(); ++hostsIterator)
+	if (error.error != QJsonParseError::NoError || !document.isObject())
 	{
-		if (hostsIterator.value().isEmpty())
-		{
-			continue;
-		}
+		Console::addMessage(tr("Failed to parse passwords file: %1").arg(error.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
 
-		QJsonArray hostArray;
-		const QList<PasswordsManager::PasswordInformation> passwords(hostsIterator.value());
+		return;
+	}
 
-		for (int i = 0; i < passwords.count(); ++i)
+	const QJsonObject hostsObject(document.object());
+	QJsonObject::const_iterator hostsIterator;
+	bool isSuccessful(true);
+
+	for (hostsIterator = hostsObject.constBegin(); hostsIterator != hostsObject.constEnd(); ++hostsIterator)
+	{
+		const QList<PasswordsManager::PasswordInformation> passwords(readPasswords(hostsIterator.value().toArray()));
+
+		if (!passwords.isEmpty())
 		{
-			QJsonArray fieldsArray;
+			m_hosts.insert(hostsIterator.key());
+			m_passwords[hostsIterator.key()] = passwords;
 
-			for (int j = 0; j < passwords.at(i).fields.count(); ++j)
+			if (!saveHost(hostsIterator.key()))
 			{
-				QJsonObject fieldObject;
-				fieldObject.insert(QLatin1String("name"), passwords.at(i).fields.at(j).name);
-				fieldObject.insert(QLatin1String("value"), passwords.at(i).fields.at(j).value);
-				fieldObject.insert(QLatin1String("type"), ((passwords.at(i).fields.at(j).type == PasswordsManager::PasswordField) ? QLatin1String("password") : QLatin1String("text")));
-
-				fieldsArray.append(fieldObject);
+				isSuccessful = false;
 			}
+		}
+	}
 
-			QJsonObject passwordObject;
-			passwordObject.insert(QLatin1String("url"), passwords.at(i).url.toString());
+	if (isSuccessful && saveIndex())
+	{
+		QFile::remove(path);
+	}
+	else
+	{
+		Console::addMessage(tr("Failed to migrate passwords file, keeping it for next attempt"), Console::OtherCategory, Console::ErrorLevel, path);
+	}
 
-			if (passwords.at(i).timeAdded.isValid())
-			{
-				passwordObject.insert(QLatin1String("timeAdded"), passwords.at(i).timeAdded.toString(Qt::ISODate));
-			}
+	emit passwordsModified();
+}
 
-			if (passwords.at(i).timeUsed.isValid())
-			{
-				passwordObject.insert(QLatin1String("timeUsed"), passwords.at(i).timeUsed.toString(Qt::ISODate));
-			}
+bool FilePasswordsStorageBackend::saveHost(const QString &host)
+{
+	const QString path(getHostPath(host));
+
+	if (!m_passwords.contains(host) || m_passwords[host].isEmpty())
+	{
+		return (!QFile::exists(path) || QFile::remove(path));
+	}
+
+	QDir().mkpath(getStoragePath());
+
+	QSaveFile file(path);
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		Console::addMessage(tr("Failed to save passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		return false;
+	}
+
+	file.write(QJsonDocument(writePasswords(m_passwords[host])).toJson(QJsonDocument::Compact));
+
+	if (!file.commit())
+	{
+		Console::addMessage(tr("Failed to save passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+
+		return false;
+	}
+
+	return true;
+}
+
+bool FilePasswordsStorageBackend::saveIndex()
+{
+	QDir().mkpath(getStoragePath());
+
+	QSaveFile file(getIndexPath());
 
-			passwordObject.insert(QLatin1String("type"), ((passwords.at(i).type == PasswordsManager::AuthPassword) ? QLatin1String("auth") : QLatin1String("form")));
-			passwordObject.insert(QLatin1String("fields"), fieldsArray);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		Console::addMessage(tr("Failed to save passwords index file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		return false;
+	}
+
+	QJsonArray hostsArray;
+	QSet<QString>::const_iterator iterator;
 
-			hostArray.append(passwordObject);
+	for (iterator = m_hosts.constBegin(); iterator != m_hosts.constEnd(); ++iterator)
+	{
+		hostsArray.append(*iterator);
+	}
+
+	file.write(QJsonDocument(hostsArray).toJson(QJsonDocument::Compact));
+
+	return file.commit();
+}
+
+bool FilePasswordsStorageBackend::updateHost(const QString &host)
+{
+	if (m_isReadOnly)
+	{
+		m_passwords.remove(host);
+
+		Console::addMessage(tr("Refusing to save passwords while passwords index file could not be read"), Console::OtherCategory, Console::ErrorLevel, getIndexPath());
+
+		emit passwordsModified();
+
+		return false;
+	}
+
+	if (m_unloadableHosts.contains(host))
+	{
+		m_passwords.remove(host);
+
+		Console::addMessage(tr("Refusing to overwrite passwords file that could not be read"), Console::OtherCategory, Console::ErrorLevel, getHostPath(host));
+
+		return false;
+	}
+
+	const bool hasPasswords(m_passwords.contains(host) && !m_passwords[host].isEmpty());
+
+	if (!hasPasswords)
+	{
+		m_passwords.remove(host);
+	}
+
+	if (!saveHost(host))
+	{
+		m_passwords.remove(host);
+
+		emit passwordsModified();
+
+		return false;
+	}
+
+	if (hasPasswords != m_hosts.contains(host))
+	{
+		if (hasPasswords)
+		{
+			m_hosts.insert(host);
+		}
+		else
+		{
+			m_hosts.remove(host);
 		}
 
-		hostsObject.insert(hostsIterator.key(), hostArray);
+		if (!saveIndex())
+		{
+			emit passwordsModified();
+
+			return false;
+		}
 	}
 
-	file.write(QJsonDocument(hostsObject).toJson(QJsonDocument::Indented));
-	file.close();
+	emit passwordsModified();
+
+	return true;
 }
 
 void FilePasswordsStorageBackend::clearPasswords(const QString &host)
@@ -165,18 +345,12 @@ void FilePasswordsStorageBackend::clearPasswords(const QString &host)
 		initialize();
 	}
 
-	if (m_passwords.isEmpty())
-	{
-		return;
-	}
-
-	if (m_passwords.contains(host))
+	if (m_hosts.contains(host))
 	{
 		m_passwords.remove(host);
+		m_unloadableHosts.remove(host);
 
-		emit passwordsModified();
-
-		save();
+		updateHost(host);
 	}
 }
 
@@ -184,18 +358,31 @@ void FilePasswordsStorageBackend::clearPasswords(int period)
 {
 	if (period <= 0)
 	{
-		const QString path(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
+		const QString legacyPath(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
 
-		if (!QFile::remove(path))
+		if (QFile::exists(legacyPath))
 		{
-			Console::addMessage(tr("Failed to remove passwords file"), Console::OtherCategory, Console::ErrorLevel, path);
+			QFile::remove(legacyPath);
 		}
-		else if (!m_passwords.isEmpty())
+
+		if (QFile::exists(getStoragePath()) && !QDir(getStoragePath()).removeRecursively())
+		{
+			Console::addMessage(tr("Failed to remove passwords file"), Console::OtherCategory, Console::ErrorLevel, getStoragePath());
+		}
+
+		m_isInitialized = true;
+		m_isReadOnly = false;
+
+		if (!m_hosts.isEmpty())
 		{
+			m_hosts.clear();
 			m_passwords.clear();
+			m_unloadableHosts.clear();
 
 			emit passwordsModified();
 		}
+
+		return;
 	}
 
 	if (!m_isInitialized)
@@ -203,46 +390,35 @@ void FilePasswordsStorageBackend::clearPasswords(int period)
 		initialize();
 	}
 
-	if (m_passwords.isEmpty())
+	const QDateTime currentDateTime(QDateTime::currentDateTime());
+	const QStringList hosts(m_hosts.toList());
+
+	for (int i = 0; i < hosts.count(); ++i)
 	{
-		return;
-	}
+		QList<PasswordsManager::PasswordInformation> *passwords(getHostPasswords(hosts.at(i)));
 
-	QHash<QString, QList<PasswordsManager::PasswordInformation> >::iterator iterator(m_passwords.begin());
-	bool wasModified(false);
+		if (!passwords)
+		{
+			continue;
+		}
 
-	while (iterator != m_passwords.end())
-	{
-		QList<PasswordsManager::PasswordInformation> passwords(iterator.value());
+		bool wasModified(false);
 
-		for (int i = (passwords.count() - 1); i >= 0; --i)
+		for (int j = (passwords->count() - 1); j >= 0; --j)
 		{
-			if (passwords.at(i).timeAdded.secsTo(QDateTime::currentDateTime()) < (period * 3600))
+			if (passwords->at(j).timeAdded.secsTo(currentDateTime) < (period * 3600))
 			{
-				passwords.removeAt(i);
+				passwords->removeAt(j);
 
 				wasModified = true;
 			}
 		}
 
-		if (passwords.isEmpty())
-		{
-			iterator = m_passwords.erase(iterator);
-		}
-		else
+		if (wasModified)
 		{
-			m_passwords[iterator.key()] = passwords;
-
-			++iterator;
+			updateHost(hosts.at(i));
 		}
 	}
-
-	if (wasModified)
-	{
-		save();
-
-		emit passwordsModified();
-	}
 }
 
 void FilePasswordsStorageBackend::addPassword(const PasswordsManager::PasswordInformation &password)
@@ -252,36 +428,36 @@ void FilePasswordsStorageBackend::addPassword(const PasswordsManager::PasswordIn
 		initialize();
 	}
 
-	const QString host(password.url.host().isEmpty() ? QLatin1String("localhost") : password.url.host());
+	const QString host(getHost(password.url));
+	QList<PasswordsManager::PasswordInformation> *passwords(getHostPasswords(host));
 
-	if (m_passwords.contains(host))
+	if (!passwords)
 	{
-		const QList<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-
-		for (int i = 0; i < passwords.count(); ++i)
+		if (m_unloadableHosts.contains(host))
 		{
-			if (comparePasswords(password, passwords.at(i)) == PasswordsManager::PartialMatch)
-			{
-				m_passwords[host].replace(i, password);
-
-				emit passwordsModified();
-
-				save();
+			Console::addMessage(tr("Failed to add password, passwords file could not be read"), Console::OtherCategory, Console::ErrorLevel, getHostPath(host));
 
-				return;
-			}
+			return;
 		}
+
+		passwords = &m_passwords[host];
 	}
-	else
+
+	for (int i = 0; i < passwords->count(); ++i)
 	{
-		m_passwords[host] = QList<PasswordsManager::PasswordInformation>();
-	}
+		if (comparePasswords(password, passwords->at(i)) == PasswordsManager::PartialMatch)
+		{
+			passwords->replace(i, password);
 
-	m_passwords[host].append(password);
+			updateHost(host);
 
-	emit passwordsModified();
+			return;
+		}
+	}
+
+	passwords->append(password);
 
-	save();
+	updateHost(host);
 }
 
 void FilePasswordsStorageBackend::removePassword(const PasswordsManager::PasswordInformation &password)
@@ -291,24 +467,21 @@ void FilePasswordsStorageBackend::removePassword(const PasswordsManager::Passwor
 		initialize();
 	}
 
-	const QString host(password.url.host().isEmpty() ? QLatin1String("localhost") : password.url.host());
+	const QString host(getHost(password.url));
+	QList<PasswordsManager::PasswordInformation> *passwords(getHostPasswords(host));
 
-	if (!m_passwords.contains(host))
+	if (!passwords)
 	{
 		return;
 	}
 
-	const QList<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-
-	for (int i = 0; i < passwords.count(); ++i)
+	for (int i = 0; i < passwords->count(); ++i)
 	{
-		if (comparePasswords(password, passwords.at(i)) != PasswordsManager::NoMatch)
+		if (comparePasswords(password, passwords->at(i)) != PasswordsManager::NoMatch)
 		{
-			m_passwords[host].removeAt(i);
-
-			emit passwordsModified();
+			passwords->removeAt(i);
 
-			save();
+			updateHost(host);
 
 			return;
 		}
@@ -340,6 +513,26 @@ QIcon FilePasswordsStorageBackend::getIcon() const
 	return QIcon();
 }
 
+QString FilePasswordsStorageBackend::getHost(const QUrl &url)
+{
+	return (url.host().isEmpty() ? QLatin1String("localhost") : url.host());
+}
+
+QString FilePasswordsStorageBackend::getStoragePath()
+{
+	return SessionsManager::getWritableDataPath(QLatin1String("passwords"));
+}
+
+QString FilePasswordsStorageBackend::getIndexPath()
+{
+	return QDir(getStoragePath()).filePath(QLatin1String("index.json"));
+}
+
+QString FilePasswordsStorageBackend::getHostPath(const QString &host)
+{
+	return QDir(getStoragePath()).filePath(QString::fromLatin1(QCryptographicHash::hash(host.toUtf8(), QCryptographicHash::Sha1).toHex()) + QLatin1String(".json"));
+}
+
 QStringList FilePasswordsStorageBackend::getHosts()
 {
 	if (!m_isInitialized)
@@ -347,7 +540,80 @@ QStringList FilePasswordsStorageBackend::getHosts()
 		initialize();
 	}
 
-	return m_passwords.keys();
+	return m_hosts.toList();
+}
+
+QList<PasswordsManager::PasswordInformation> FilePasswordsStorageBackend::readPasswords(const QJsonArray &array)
+{
+	QList<PasswordsManager::PasswordInformation> passwords;
+	passwords.reserve(array.count());
+
+	for (int i = 0; i < array.count(); ++i)
+	{
+		const QJsonObject passwordObject(array.at(i).toObject());
+		PasswordsManager::PasswordInformation password;
+		password.url = QUrl(passwordObject.value(QLatin1String("url")).toString());
+		password.timeAdded = QDateTime::fromString(passwordObject.value(QLatin1String("timeAdded")).toString(), Qt::ISODate);
+		password.timeUsed = QDateTime::fromString(passwordObject.value(QLatin1String("timeUsed")).toString(), Qt::ISODate);
+		password.type = ((passwordObject.value(QLatin1String("type")).toString() == QLatin1String("auth")) ? PasswordsManager::AuthPassword : PasswordsManager::FormPassword);
+
+		const QJsonArray fieldsArray(passwordObject.value(QLatin1String("fields")).toArray());
+
+		for (int j = 0; j < fieldsArray.count(); ++j)
+		{
+			const QJsonObject fieldObject(fieldsArray.at(j).toObject());
+			PasswordsManager::FieldInformation field;
+			field.name = fieldObject.value(fieldObject.contains(QLatin1String("name")) ? QLatin1String("name") : QLatin1String("key")).toString();
+			field.value = fieldObject.value(QLatin1String("value")).toString();
+			field.type = ((fieldObject.value(QLatin1String("type")).toString() == QLatin1String("password")) ? PasswordsManager::PasswordField : PasswordsManager::TextField);
+
+			password.fields.append(field);
+		}
+
+		passwords.append(password);
+	}
+
+	return passwords;
+}
+
+QList<PasswordsManager::PasswordInformation>* FilePasswordsStorageBackend::getHostPasswords(const QString &host)
+{
+	if (!m_hosts.contains(host) || m_unloadableHosts.contains(host))
+	{
+		return nullptr;
+	}
+
+	if (!m_passwords.contains(host))
+	{
+		QFile file(getHostPath(host));
+
+		if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			Console::addMessage(tr("Failed to open passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+			m_unloadableHosts.insert(host);
+
+			return nullptr;
+		}
+
+		QJsonParseError error;
+		const QJsonDocument document(QJsonDocument::fromJson(file.readAll(), &error));
+
+		file.close();
+
+		if (error.error != QJsonParseError::NoError || !document.isArray())
+		{
+			Console::addMessage(tr("Failed to parse passwords file: %1").arg(error.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+			m_unloadableHosts.insert(host);
+
+			return nullptr;
+		}
+
+		m_passwords[host] = readPasswords(document.array());
+	}
+
+	return &m_passwords[host];
 }
 
 QList<PasswordsManager::PasswordInformation> FilePasswordsStorageBackend::getPasswords(const QUrl &url, PasswordsManager::PasswordTypes types)
@@ -357,30 +623,80 @@ QList<PasswordsManager::PasswordInformation> FilePasswordsStorageBackend::getPas
 		initialize();
 	}
 
-	const QString host(url.host().isEmpty() ? QLatin1String("localhost") : url.host());
+	const QList<PasswordsManager::PasswordInformation> *passwords(getHostPasswords(getHost(url)));
+
+	if (!passwords)
+	{
+		return QList<PasswordsManager::PasswordInformation>();
+	}
+
+	int amount(0);
 
-	if (m_passwords.contains(host))
+	for (int i = 0; i < passwords->count(); ++i)
 	{
-		if (types == PasswordsManager::AnyPassword)
+		if (types.testFlag(passwords->at(i).type))
 		{
-			return m_passwords[host];
+			++amount;
 		}
+	}
 
-		const QList<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-		QList<PasswordsManager::PasswordInformation> matchingPasswords;
+	if (amount == passwords->count())
+	{
+		return *passwords;
+	}
 
-		for (int i = 0; i < passwords.count(); ++i)
+	QList<PasswordsManager::PasswordInformation> matchingPasswords;
+	matchingPasswords.reserve(amount);
+
+	for (int i = 0; i < passwords->count(); ++i)
+	{
+		if (types.testFlag(passwords->at(i).type))
 		{
-			if (types.testFlag(passwords.at(i).type))
-			{
-				matchingPasswords.append(passwords.at(i));
-			}
+			matchingPasswords.append(passwords->at(i));
 		}
+	}
+
+	return matchingPasswords;
+}
 
-		return matchingPasswords;
+QJsonArray FilePasswordsStorageBackend::writePasswords(const QList<PasswordsManager::PasswordInformation> &passwords)
+{
+	QJsonArray array;
+
+	for (int i = 0; i < passwords.count(); ++i)
+	{
+		QJsonArray fieldsArray;
+
+		for (int j = 0; j < passwords.at(i).fields.count(); ++j)
+		{
+			QJsonObject fieldObject;
+			fieldObject.insert(QLatin1String("name"), passwords.at(i).fields.at(j).name);
+			fieldObject.insert(QLatin1String("value"), passwords.at(i).fields.at(j).value);
+			fieldObject.insert(QLatin1String("type"), ((passwords.at(i).fields.at(j).type == PasswordsManager::PasswordField) ? QLatin1String("password") : QLatin1String("text")));
+
+			fieldsArray.append(fieldObject);
+		}
+
+		QJsonObject passwordObject;
+		passwordObject.insert(QLatin1String("url"), passwords.at(i).url.toString());
+
+		if (passwords.at(i).timeAdded.isValid())
+		{
+			passwordObject.insert(QLatin1String("timeAdded"), passwords.at(i).timeAdded.toString(Qt::ISODate));
+		}
+
+		if (passwords.at(i).timeUsed.isValid())
+		{
+			passwordObject.insert(QLatin1String("timeUsed"), passwords.at(i).timeUsed.toString(Qt::ISODate));
+		}
+
+		passwordObject.insert(QLatin1String("type"), ((passwords.at(i).type == PasswordsManager::AuthPassword) ? QLatin1String("auth") : QLatin1String("form")));
+		passwordObject.insert(QLatin1String("fields"), fieldsArray);
+
+		array.append(passwordObject);
 	}
 
-	return QList<PasswordsManager::PasswordInformation>();
+	return array;
 }
 
 PasswordsManager::PasswordMatch FilePasswordsStorageBackend::hasPassword(const PasswordsManager::PasswordInformation &password)
@@ -390,18 +706,16 @@ PasswordsManager::PasswordMatch FilePasswordsStorageBackend::hasPassword(const P
 		initialize();
 	}
 
-	const QString host(password.url.host().isEmpty() ? QLatin1String("localhost") : password.url.host());
+	const QList<PasswordsManager::PasswordInformation> *passwords(getHostPasswords(getHost(password.url)));
 
-	if (!m_passwords.contains(host))
+	if (!passwords)
 	{
 		return PasswordsManager::NoMatch;
 	}
 
-	const QList<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-
-	for (int i = 0; i < passwords.count(); ++i)
+	for (int i = 0; i < passwords->count(); ++i)
 	{
-		const PasswordsManager::PasswordMatch match(comparePasswords(password, passwords.at(i)));
+		const PasswordsManager::PasswordMatch match(comparePasswords(password, passwords->at(i)));
 
 		if (match != PasswordsManager::NoMatch)
 		{
@@ -419,20 +733,20 @@ bool FilePasswordsStorageBackend::hasPasswords(const QUrl &url, PasswordsManager
 		initialize();
 	}
 
-	const QString host(url.host().isEmpty() ? QLatin1String("localhost") : url.host());
+	const QString host(getHost(url));
 
 	if (types == PasswordsManager::AnyPassword)
 	{
-		return m_passwords.contains(host);
+		return m_hosts.contains(host);
 	}
 
-	if (m_passwords.contains(host))
-	{
-		const QList<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
+	const QList<PasswordsManager::PasswordInformation> *passwords(getHostPasswords(host));
 
-		for (int i = 0; i < passwords.count(); ++i)
+	if (passwords)
+	{
+		for (int i = 0; i < passwords->count(); ++i)
 		{
-			if (types.testFlag(passwords.at(i).type))
+			if (types.testFlag(passwords->at(i).type))
 			{
 				return true;
 			}
@@ -22,6 +22,9 @@
 
 #include "../../../../core/PasswordsStorageBackend.h"
 
+#include <QtCore/QJsonArray>
+#include <QtCore/QSet>
+
 namespace Meerkat
 {
 
@@ -48,11 +51,25 @@ public:
 
 protected:
 	void initialize();
-	void save();
+	void migrate(const QString &path);
+	void rebuildIndex();
+	bool updateHost(const QString &host);
+	static QString getHost(const QUrl &url);
+	static QString getStoragePath();
+	static QString getIndexPath();
+	static QString getHostPath(const QString &host);
+	static QList<PasswordsManager::PasswordInformation> readPasswords(const QJsonArray &array);
+	QList<PasswordsManager::PasswordInformation>* getHostPasswords(const QString &host);
+	static QJsonArray writePasswords(const QList<PasswordsManager::PasswordInformation> &passwords);
+	bool saveHost(const QString &host);
+	bool saveIndex();
 
 private:
 	QHash<QString, QList<PasswordsManager::PasswordInformation> > m_passwords;
+	QSet<QString> m_hosts;
+	QSet<QString> m_unloadableHosts;
 	bool m_isInitialized;
+	bool m_isReadOnly;
 };
 
 }
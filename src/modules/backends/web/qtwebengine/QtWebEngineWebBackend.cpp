@@ -299,10 +299,11 @@ QIcon QtWebEngineWebBackend::getIcon() const
 	return QIcon();
 }
 
-bool QtWebEngineWebBackend::requestThumbnail(const QUrl &url, const QSize &size)
+bool QtWebEngineWebBackend::requestThumbnail(const QUrl &url, const QSize &size, bool hasPriority)
 {
 	Q_UNUSED(url)
 	Q_UNUSED(size)
+	Q_UNUSED(hasPriority)
 
 	return false;
 }
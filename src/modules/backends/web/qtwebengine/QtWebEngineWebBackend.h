@@ -48,7 +48,7 @@ public:
 	QStringList getBlockedElements(const QString &domain) const;
 	QUrl getHomePage() const;
 	QIcon getIcon() const;
-	bool requestThumbnail(const QUrl &url, const QSize &size);
+	bool requestThumbnail(const QUrl &url, const QSize &size, bool hasPriority = false);
 
 protected slots:
 	void optionChanged(int identifier);
@@ -19,38 +19,218 @@
 
 #include "QtWebKitHistoryInterface.h"
 #include "../../../../core/HistoryManager.h"
+#include "../../../../core/Utils.h"
+
+#include <QtConcurrent/QtConcurrentRun>
 
 namespace Meerkat
 {
 
-QtWebKitHistoryInterface::QtWebKitHistoryInterface(QObject *parent) : QWebHistoryInterface(parent)
+QtWebKitHistoryInterface::QtWebKitHistoryInterface(QObject *parent) : QWebHistoryInterface(parent),
+	m_indexWatcher(nullptr),
+	m_isIndexReady(false),
+	m_needsIndexUpdate(false)
 {
-	connect(HistoryManager::getBrowsingHistoryModel(), SIGNAL(cleared()), this, SLOT(clear()));
+	HistoryModel *model(HistoryManager::getBrowsingHistoryModel());
+
+	createIndex();
+
+	connect(model, SIGNAL(cleared()), this, SLOT(clear()));
+	connect(model, SIGNAL(entryAdded(HistoryEntryItem*)), this, SLOT(handleEntryAdded(HistoryEntryItem*)));
+	connect(model, SIGNAL(entryUrlChanged(HistoryEntryItem*,QUrl)), this, SLOT(handleEntryUrlChanged(HistoryEntryItem*,QUrl)));
+	connect(model, SIGNAL(entryRemoved(HistoryEntryItem*)), this, SLOT(handleEntryRemoved(HistoryEntryItem*)));
 }
 
 void QtWebKitHistoryInterface::clear()
 {
-	m_urls.clear();
+	m_recentFingerprints.clear();
+	m_recentOrder.clear();
+
+	createIndex();
+}
+
+void QtWebKitHistoryInterface::createIndex()
+{
+	if (m_indexWatcher)
+	{
+		m_needsIndexUpdate = true;
+
+		return;
+	}
+
+	m_needsIndexUpdate = false;
+	m_isIndexReady = false;
+
+	m_fingerprints.clear();
+
+	m_indexWatcher = new QFutureWatcher<QSet<quint64> >(this);
+
+	connect(m_indexWatcher, SIGNAL(finished()), this, SLOT(handleIndexCreated()));
+
+	m_indexWatcher->setFuture(QtConcurrent::run(&QtWebKitHistoryInterface::createFingerprints, HistoryManager::getBrowsingHistoryModel()->getUrls()));
 }
 
 void QtWebKitHistoryInterface::addHistoryEntry(const QString &url)
 {
-	if (m_urls.contains(url))
+	const quint64 fingerprint(getFingerprint(url));
+
+	if (m_recentFingerprints.contains(fingerprint))
+	{
+		return;
+	}
+
+	m_recentFingerprints.insert(fingerprint);
+	m_recentOrder.append(fingerprint);
+
+	if (m_recentOrder.count() > 100)
+	{
+		m_recentFingerprints.remove(m_recentOrder.takeFirst());
+	}
+}
+
+void QtWebKitHistoryInterface::handleEntryAdded(HistoryEntryItem *entry)
+{
+	if (!entry)
+	{
+		return;
+	}
+
+	const QList<quint64> fingerprints(getFingerprints(entry->data(HistoryModel::UrlRole).toUrl()));
+
+	for (int i = 0; i < fingerprints.count(); ++i)
+	{
+		m_fingerprints.insert(fingerprints.at(i));
+	}
+}
+
+void QtWebKitHistoryInterface::handleEntryUrlChanged(HistoryEntryItem *entry, const QUrl &previousUrl)
+{
+	removeFingerprints(previousUrl);
+	handleEntryAdded(entry);
+}
+
+void QtWebKitHistoryInterface::handleEntryRemoved(HistoryEntryItem *entry)
+{
+	if (!entry)
+	{
+		return;
+	}
+
+	removeFingerprints(entry->data(HistoryModel::UrlRole).toUrl());
+}
+
+void QtWebKitHistoryInterface::removeFingerprints(const QUrl &url)
+{
+	if (url.isEmpty() || HistoryManager::hasEntry(Utils::normalizeUrl(url)))
 	{
 		return;
 	}
 
-	m_urls.append(url);
+	if (m_indexWatcher)
+	{
+		m_needsIndexUpdate = true;
+	}
+
+	const QList<quint64> fingerprints(getFingerprints(url));
+
+	for (int i = 0; i < fingerprints.count(); ++i)
+	{
+		m_fingerprints.remove(fingerprints.at(i));
+	}
+}
+
+void QtWebKitHistoryInterface::handleIndexCreated()
+{
+	m_fingerprints.unite(m_indexWatcher->result());
+
+	m_indexWatcher->deleteLater();
+	m_indexWatcher = nullptr;
+
+	if (m_needsIndexUpdate)
+	{
+		createIndex();
+	}
+	else
+	{
+		m_isIndexReady = true;
+	}
+}
+
+QSet<quint64> QtWebKitHistoryInterface::createFingerprints(const QList<QUrl> &urls)
+{
+	QSet<quint64> fingerprints;
+	fingerprints.reserve(urls.count() * 2);
+
+	for (int i = 0; i < urls.count(); ++i)
+	{
+		const QList<quint64> urlFingerprints(getFingerprints(urls.at(i)));
+
+		for (int j = 0; j < urlFingerprints.count(); ++j)
+		{
+			fingerprints.insert(urlFingerprints.at(j));
+		}
+	}
+
+	return fingerprints;
+}
+
+QList<quint64> QtWebKitHistoryInterface::getFingerprints(QUrl url)
+{
+	url = Utils::normalizeUrl(url);
+
+	const quint64 encodedFingerprint(getFingerprint(url.toString(QUrl::FullyEncoded)));
+	const quint64 decodedFingerprint(getFingerprint(url.toString()));
+
+	if (encodedFingerprint == decodedFingerprint)
+	{
+		return QList<quint64>({encodedFingerprint});
+	}
+
+	return QList<quint64>({encodedFingerprint, decodedFingerprint});
+}
+
+quint64 QtWebKitHistoryInterface::getFingerprint(const QString &url)
+{
+	const ushort *characters(url.utf16());
+	const int length(url.length());
+	quint64 fingerprint(Q_UINT64_C(14695981039346656037));
 
-	if (m_urls.length() > 100)
+	for (int i = 0; i < length; ++i)
 	{
-		m_urls.removeAt(0);
+		fingerprint ^= characters[i];
+		fingerprint *= Q_UINT64_C(1099511628211);
 	}
+
+	return fingerprint;
 }
 
 bool QtWebKitHistoryInterface::historyContains(const QString &url) const
 {
-	return (m_urls.contains(url) || HistoryManager::hasEntry(url));
+	const quint64 fingerprint(getFingerprint(url));
+
+	if (m_recentFingerprints.contains(fingerprint))
+	{
+		return true;
+	}
+
+	if (!HistoryManager::isEnabled())
+	{
+		return false;
+	}
+
+	if (m_fingerprints.contains(fingerprint))
+	{
+		return true;
+	}
+
+	const QUrl normalizedUrl(Utils::normalizeUrl(QUrl(url)));
+
+	if (m_fingerprints.contains(getFingerprint(normalizedUrl.toString(QUrl::FullyEncoded))))
+	{
+		return true;
+	}
+
+	return (!m_isIndexReady && HistoryManager::hasEntry(normalizedUrl));
 }
 
 }
@@ -20,12 +20,16 @@
 #ifndef MEERKAT_QTWEBKITHISTORYINTERFACE_H
 #define MEERKAT_QTWEBKITHISTORYINTERFACE_H
 
-#include <QtCore/QStringList>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QSet>
+#include <QtCore/QUrl>
 #include <QtWebKit/QWebHistoryInterface>
 
 namespace Meerkat
 {
 
+class HistoryEntryItem;
+
 class QtWebKitHistoryInterface : public QWebHistoryInterface
 {
 	Q_OBJECT
@@ -36,11 +40,27 @@ public:
 	void addHistoryEntry(const QString &url);
 	bool historyContains(const QString &url) const;
 
+protected:
+	void createIndex();
+	void removeFingerprints(const QUrl &url);
+	static QSet<quint64> createFingerprints(const QList<QUrl> &urls);
+	static QList<quint64> getFingerprints(QUrl url);
+	static quint64 getFingerprint(const QString &url);
+
 protected slots:
 	void clear();
+	void handleEntryAdded(HistoryEntryItem *entry);
+	void handleEntryUrlChanged(HistoryEntryItem *entry, const QUrl &previousUrl);
+	void handleEntryRemoved(HistoryEntryItem *entry);
+	void handleIndexCreated();
 
 private:
-	QStringList m_urls;
+	QFutureWatcher<QSet<quint64> > *m_indexWatcher;
+	QSet<quint64> m_fingerprints;
+	QSet<quint64> m_recentFingerprints;
+	QList<quint64> m_recentOrder;
+	bool m_isIndexReady;
+	bool m_needsIndexUpdate;
 };
 
 }
@@ -28,9 +28,12 @@
 #include "../../../../core/LocalListingNetworkReply.h"
 #include "../../../../core/NetworkCache.h"
 #include "../../../../core/NetworkManagerFactory.h"
+#include "../../../../core/NetworkTransport.h"
 #include "../../../../core/PasswordsManager.h"
+#include "../../../../core/PreconnectManager.h"
 #include "../../../../core/SettingsManager.h"
 #include "../../../../core/ThemesManager.h"
+#include "../../../../core/Tracer.h"
 #include "../../../../core/WebBackend.h"
 #include "../../../../ui/AuthenticationDialog.h"
 #include "../../../../ui/ContentsDialog.h"
@@ -43,10 +46,14 @@
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QNetworkReply>
 
+#define PAGE_INFORMATION_UPDATE_INTERVAL 100
+
 namespace Meerkat
 {
 
 WebBackend* QtWebKitNetworkManager::m_backend(nullptr);
+QHash<QByteArray, int> QtWebKitNetworkManager::m_acceptHints;
+QHash<QString, int> QtWebKitNetworkManager::m_extensionHints;
 
 QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar *cookieJarProxy, QtWebKitWebWidget *parent) : QNetworkAccessManager(parent),
 	m_widget(parent),
@@ -54,15 +61,43 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	m_cookieJarProxy(cookieJarProxy),
 	m_baseReply(nullptr),
 	m_contentState(WindowsManager::UnknownContentState),
-	m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy),
+	m_documentLoadingProgress(0),
+	m_bytesReceived(0),
+	m_bytesTotal(0),
 	m_bytesReceivedDifference(0),
+	m_loadingSpeed(0),
+	m_changedInformation(0),
 	m_securityState(UnknownState),
+	m_loadingMessage(NoLoadingMessage),
+	m_requestsStarted(0),
+	m_requestsFinished(0),
 	m_loadingSpeedTimer(0),
+	m_updateTimer(0),
 	m_areImagesEnabled(true),
-	m_canSendReferrer(true)
+	m_canSendReferrer(true),
+	m_isPrivate(isPrivate)
 {
 	NetworkManagerFactory::initialize();
 
+	m_acceptLanguageHeader = NetworkManagerFactory::getAcceptLanguage().toLatin1();
+
+	if (m_acceptHints.isEmpty())
+	{
+		m_acceptHints[QByteArray("text/html")] = DocumentHint;
+		m_acceptHints[QByteArray("application/xhtml+xml")] = DocumentHint;
+		m_acceptHints[QByteArray("application/xml")] = DocumentHint;
+		m_acceptHints[QByteArray("image/")] = ImageHint;
+		m_acceptHints[QByteArray("text/css")] = StyleSheetHint;
+
+		m_extensionHints[QLatin1String("htm")] = DocumentHint;
+		m_extensionHints[QLatin1String("html")] = DocumentHint;
+		m_extensionHints[QLatin1String("png")] = ImageHint;
+		m_extensionHints[QLatin1String("jpg")] = ImageHint;
+		m_extensionHints[QLatin1String("gif")] = ImageHint;
+		m_extensionHints[QLatin1String("js")] = ScriptHint;
+		m_extensionHints[QLatin1String("css")] = StyleSheetHint;
+	}
+
 	if (!isPrivate)
 	{
 		m_cookieJar = NetworkManagerFactory::getCookieJar();
@@ -99,9 +134,14 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 
 void QtWebKitNetworkManager::timerEvent(QTimerEvent *event)
 {
-	Q_UNUSED(event)
-
-	updateLoadingSpeed();
+	if (event->timerId() == m_updateTimer)
+	{
+		updatePageInformation();
+	}
+	else if (event->timerId() == m_loadingSpeedTimer)
+	{
+		updateLoadingSpeed();
+	}
 }
 
 void QtWebKitNetworkManager::addContentBlockingException(const QUrl &url, NetworkManager::ResourceType resourceType)
@@ -118,8 +158,6 @@ void QtWebKitNetworkManager::resetStatistics()
 {
 	killTimer(m_loadingSpeedTimer);
 
-	const QList<WebWidget::PageInformation> keys(m_pageInformation.keys());
-
 	m_sslInformation = WebWidget::SslInformation();
 	m_loadingSpeedTimer = 0;
 	m_blockedElements.clear();
@@ -127,22 +165,30 @@ void QtWebKitNetworkManager::resetStatistics()
 	m_contentBlockingExceptions.clear();
 	m_blockedRequests.clear();
 	m_replies.clear();
-	m_pageInformation.clear();
-	m_pageInformation[WebWidget::BytesReceivedInformation] = quint64(0);
-	m_pageInformation[WebWidget::BytesTotalInformation] = quint64(0);
-	m_pageInformation[WebWidget::RequestsFinishedInformation] = 0;
-	m_pageInformation[WebWidget::RequestsStartedInformation] = 0;
+	m_loadingMessageHost.clear();
+	m_loadingFinished = QDateTime();
 	m_baseReply = nullptr;
 	m_contentState = WindowsManager::UnknownContentState;
+	m_documentLoadingProgress = 0;
+	m_bytesReceived = 0;
+	m_bytesTotal = 0;
 	m_bytesReceivedDifference = 0;
 	m_securityState = UnknownState;
+	m_loadingMessage = NoLoadingMessage;
+	m_requestsStarted = 0;
+	m_requestsFinished = 0;
 
 	updateLoadingSpeed();
 
-	for (int i = 0; i < keys.count(); ++i)
-	{
-		emit pageInformationChanged(keys.at(i), m_pageInformation.value(keys.at(i)));
-	}
+	markPageInformationChanged(WebWidget::DocumentLoadingProgressInformation);
+	markPageInformationChanged(WebWidget::BytesReceivedInformation);
+	markPageInformationChanged(WebWidget::BytesTotalInformation);
+	markPageInformationChanged(WebWidget::RequestsBlockedInformation);
+	markPageInformationChanged(WebWidget::RequestsFinishedInformation);
+	markPageInformationChanged(WebWidget::RequestsStartedInformation);
+	markPageInformationChanged(WebWidget::LoadingFinishedInformation);
+	markPageInformationChanged(WebWidget::LoadingMessageInformation);
+	updatePageInformation();
 
 	emit contentStateChanged(m_contentState);
 }
@@ -171,7 +217,9 @@ void QtWebKitNetworkManager::downloadProgress(qint64 bytesReceived, qint64 bytes
 		}
 		else
 		{
-			setPageInformation(WebWidget::DocumentLoadingProgressInformation, ((bytesTotal > 0) ? (((bytesReceived * 1.0) / bytesTotal) * 100) : -1));
+			m_documentLoadingProgress = ((bytesTotal > 0) ? (((bytesReceived * 1.0) / bytesTotal) * 100) : -1);
+
+			markPageInformationChanged(WebWidget::DocumentLoadingProgressInformation);
 		}
 	}
 
@@ -184,7 +232,7 @@ void QtWebKitNetworkManager::downloadProgress(qint64 bytesReceived, qint64 bytes
 
 	if (url.isValid() && url.scheme() != QLatin1String("data"))
 	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Receiving data from %1…").arg(reply->url().host().isEmpty() ? QLatin1String("localhost") : reply->url().host()));
+		setLoadingMessage(ReceivingDataMessage, url.host());
 	}
 
 	const qint64 difference(bytesReceived - m_replies[reply].first);
@@ -195,7 +243,9 @@ void QtWebKitNetworkManager::downloadProgress(qint64 bytesReceived, qint64 bytes
 	{
 		m_replies[reply].second = true;
 
-		m_pageInformation[WebWidget::BytesTotalInformation] = (m_pageInformation[WebWidget::BytesTotalInformation].toULongLong() + bytesTotal);
+		m_bytesTotal += bytesTotal;
+
+		markPageInformationChanged(WebWidget::BytesTotalInformation);
 	}
 
 	if (difference <= 0)
@@ -203,9 +253,10 @@ void QtWebKitNetworkManager::downloadProgress(qint64 bytesReceived, qint64 bytes
 		return;
 	}
 
+	m_bytesReceived += difference;
 	m_bytesReceivedDifference += difference;
 
-	setPageInformation(WebWidget::BytesReceivedInformation, (m_pageInformation[WebWidget::BytesReceivedInformation].toULongLong() + difference));
+	markPageInformationChanged(WebWidget::BytesReceivedInformation);
 }
 
 void QtWebKitNetworkManager::requestFinished(QNetworkReply *reply)
@@ -219,7 +270,9 @@ void QtWebKitNetworkManager::requestFinished(QNetworkReply *reply)
 
 	m_replies.remove(reply);
 
-	setPageInformation(WebWidget::RequestsFinishedInformation, (m_pageInformation[WebWidget::RequestsFinishedInformation].toInt() + 1));
+	++m_requestsFinished;
+
+	markPageInformationChanged(WebWidget::RequestsFinishedInformation);
 
 	if (reply == m_baseReply)
 	{
@@ -237,7 +290,7 @@ void QtWebKitNetworkManager::requestFinished(QNetworkReply *reply)
 
 	if (url.isValid() && url.scheme() != QLatin1String("data"))
 	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Completed request to %1").arg(url.host().isEmpty() ? QLatin1String("localhost") : reply->url().host()));
+		setLoadingMessage(CompletedRequestMessage, url.host());
 	}
 
 	disconnect(reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(downloadProgress(qint64,qint64)));
@@ -269,7 +322,7 @@ void QtWebKitNetworkManager::transferFinished()
 
 void QtWebKitNetworkManager::handleAuthenticationRequired(QNetworkReply *reply, QAuthenticator *authenticator)
 {
-	setPageInformation(WebWidget::LoadingMessageInformation, tr("Waiting for authentication…"));
+	setLoadingMessage(WaitingForAuthenticationMessage);
 
 	AuthenticationDialog *authenticationDialog(new AuthenticationDialog(reply->url(), authenticator, AuthenticationDialog::HttpAuthentication, m_widget));
 	authenticationDialog->setButtonsVisible(false);
@@ -294,7 +347,7 @@ void QtWebKitNetworkManager::handleProxyAuthenticationRequired(const QNetworkPro
 		return;
 	}
 
-	setPageInformation(WebWidget::LoadingMessageInformation, tr("Waiting for authentication…"));
+	setLoadingMessage(WaitingForAuthenticationMessage);
 
 	AuthenticationDialog *authenticationDialog(new AuthenticationDialog(proxy.hostName(), authenticator, AuthenticationDialog::ProxyAuthentication, m_widget));
 	authenticationDialog->setButtonsVisible(false);
@@ -392,13 +445,18 @@ void QtWebKitNetworkManager::handleOnlineStateChanged(bool isOnline)
 
 void QtWebKitNetworkManager::handleLoadingFinished()
 {
-	setPageInformation(WebWidget::LoadingFinishedInformation, QDateTime::currentDateTime());
-	setPageInformation(WebWidget::LoadingMessageInformation, tr("Loading finished"));
-	setPageInformation(WebWidget::LoadingSpeedInformation, 0);
+	m_loadingFinished = QDateTime::currentDateTime();
+	m_loadingSpeed = 0;
+
+	markPageInformationChanged(WebWidget::LoadingFinishedInformation);
+	markPageInformationChanged(WebWidget::LoadingSpeedInformation);
+	setLoadingMessage(LoadingFinishedMessage);
 	killTimer(m_loadingSpeedTimer);
 
 	m_loadingSpeedTimer = 0;
 
+	updatePageInformation();
+
 	if ((m_securityState == SecureState || (m_securityState == UnknownState && m_contentState.testFlag(WindowsManager::SecureContentState))) && m_sslInformation.errors.isEmpty())
 	{
 		m_contentState = WindowsManager::SecureContentState;
@@ -409,9 +467,34 @@ void QtWebKitNetworkManager::handleLoadingFinished()
 
 void QtWebKitNetworkManager::updateLoadingSpeed()
 {
-	setPageInformation(WebWidget::LoadingSpeedInformation, (m_bytesReceivedDifference * 2));
-
+	m_loadingSpeed = (m_bytesReceivedDifference * 2);
 	m_bytesReceivedDifference = 0;
+
+	markPageInformationChanged(WebWidget::LoadingSpeedInformation);
+}
+
+void QtWebKitNetworkManager::updatePageInformation()
+{
+	if (m_updateTimer != 0)
+	{
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+	}
+
+	const quint32 changedInformation(m_changedInformation);
+
+	m_changedInformation = 0;
+
+	for (int i = 0; i < 32; ++i)
+	{
+		if (changedInformation & (1U << i))
+		{
+			const WebWidget::PageInformation key(static_cast<WebWidget::PageInformation>(i));
+
+			emit pageInformationChanged(key, getPageInformation(key));
+		}
+	}
 }
 
 void QtWebKitNetworkManager::updateOptions(const QUrl &url)
@@ -438,22 +521,23 @@ void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 	QString acceptLanguage(m_widget->getOption(SettingsManager::Network_AcceptLanguageOption, url).toString());
 	acceptLanguage = ((acceptLanguage.isEmpty()) ? QLatin1String(" ") : acceptLanguage.replace(QLatin1String("system"), QLocale::system().bcp47Name()));
 
-	m_acceptLanguage = ((acceptLanguage == NetworkManagerFactory::getAcceptLanguage()) ? QString() : acceptLanguage);
+	m_acceptLanguageHeader = acceptLanguage.toLatin1();
 	m_userAgent = m_backend->getUserAgent(NetworkManagerFactory::getUserAgent(m_widget->getOption(SettingsManager::Network_UserAgentOption, url).toString()).value);
+	m_userAgentHeader = m_userAgent.toLatin1();
 
 	const QString doNotTrackPolicyValue(m_widget->getOption(SettingsManager::Network_DoNotTrackPolicyOption, url).toString());
 
 	if (doNotTrackPolicyValue == QLatin1String("allow"))
 	{
-		m_doNotTrackPolicy = NetworkManagerFactory::AllowToTrackPolicy;
+		m_doNotTrackHeader = QByteArray("0");
 	}
 	else if (doNotTrackPolicyValue == QLatin1String("doNotAllow"))
 	{
-		m_doNotTrackPolicy = NetworkManagerFactory::DoNotAllowToTrackPolicy;
+		m_doNotTrackHeader = QByteArray("1");
 	}
 	else
 	{
-		m_doNotTrackPolicy = NetworkManagerFactory::SkipTrackPolicy;
+		m_doNotTrackHeader.clear();
 	}
 
 	m_areImagesEnabled = (m_widget->getOption(SettingsManager::Browser_EnableImagesOption, url).toString() != QLatin1String("disabled"));
@@ -506,13 +590,24 @@ void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 	m_cookieJarProxy->setup(m_widget->getOption(SettingsManager::Network_ThirdPartyCookiesAcceptedHostsOption, url).toStringList(), m_widget->getOption(SettingsManager::Network_ThirdPartyCookiesRejectedHostsOption, url).toStringList(), generalCookiesPolicy, thirdPartyCookiesPolicy, keepMode);
 }
 
-void QtWebKitNetworkManager::setPageInformation(WebWidget::PageInformation key, const QVariant &value)
+void QtWebKitNetworkManager::markPageInformationChanged(WebWidget::PageInformation key)
+{
+	m_changedInformation |= (1U << key);
+
+	if (m_updateTimer == 0)
+	{
+		m_updateTimer = startTimer(PAGE_INFORMATION_UPDATE_INTERVAL);
+	}
+}
+
+void QtWebKitNetworkManager::setLoadingMessage(LoadingMessage message, const QString &host)
 {
-	if (m_loadingSpeedTimer != 0 || key != WebWidget::LoadingMessageInformation)
+	if (m_loadingSpeedTimer != 0)
 	{
-		m_pageInformation[key] = value;
+		m_loadingMessage = message;
+		m_loadingMessageHost = host;
 
-		emit pageInformationChanged(key, value);
+		markPageInformationChanged(WebWidget::LoadingMessageInformation);
 	}
 }
 
@@ -532,11 +627,13 @@ void QtWebKitNetworkManager::setWidget(QtWebKitWebWidget *widget)
 
 QtWebKitNetworkManager* QtWebKitNetworkManager::clone()
 {
-	return new QtWebKitNetworkManager((cache() == nullptr), m_cookieJarProxy->clone(nullptr), nullptr);
+	return new QtWebKitNetworkManager(m_isPrivate, m_cookieJarProxy->clone(nullptr), nullptr);
 }
 
 QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QIODevice *outgoingData)
 {
+	MEERKAT_TRACE_FUNCTION("network");
+
 	if (request.url() == m_formRequestUrl)
 	{
 		m_formRequestUrl = QUrl();
@@ -584,7 +681,9 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 
 	if (m_contentBlockingExceptions.isEmpty() || !m_contentBlockingExceptions.contains(request.url()))
 	{
-		if (!m_areImagesEnabled && (request.rawHeader(QByteArray("Accept")).contains(QByteArray("image/")) || request.url().path().endsWith(QLatin1String(".png")) || request.url().path().endsWith(QLatin1String(".jpg")) || request.url().path().endsWith(QLatin1String(".gif"))))
+		const int hints((!m_areImagesEnabled || (!m_contentBlockingProfiles.isEmpty() && !m_widget->isNavigating())) ? getResourceTypeHints(request) : NoHint);
+
+		if (!m_areImagesEnabled && (hints & ImageHint))
 		{
 			return QNetworkAccessManager::createRequest(QNetworkAccessManager::GetOperation, QNetworkRequest(QUrl()));
 		}
@@ -593,8 +692,6 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 		{
 			if (!m_contentBlockingProfiles.isEmpty())
 			{
-				const QByteArray acceptHeader(request.rawHeader(QByteArray("Accept")));
-				const QString path(request.url().path());
 				NetworkManager::ResourceType resourceType(NetworkManager::OtherType);
 				bool storeBlockedUrl(true);
 
@@ -602,25 +699,25 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 				{
 					resourceType = NetworkManager::MainFrameType;
 				}
-				else if (acceptHeader.contains(QByteArray("text/html")) || acceptHeader.contains(QByteArray("application/xhtml+xml")) || acceptHeader.contains(QByteArray("application/xml")) || path.endsWith(QLatin1String(".htm")) || path.endsWith(QLatin1String(".html")))
+				else if (hints & DocumentHint)
 				{
 					resourceType = NetworkManager::SubFrameType;
 				}
-				else if (acceptHeader.contains(QByteArray("image/")) || path.endsWith(QLatin1String(".png")) || path.endsWith(QLatin1String(".jpg")) || path.endsWith(QLatin1String(".gif")))
+				else if (hints & ImageHint)
 				{
 					resourceType = NetworkManager::ImageType;
 				}
-				else if (acceptHeader.contains(QByteArray("script/")) || path.endsWith(QLatin1String(".js")))
+				else if (hints & ScriptHint)
 				{
 					resourceType = NetworkManager::ScriptType;
 					storeBlockedUrl = false;
 				}
-				else if (acceptHeader.contains(QByteArray("text/css")) || path.endsWith(QLatin1String(".css")))
+				else if (hints & StyleSheetHint)
 				{
 					resourceType = NetworkManager::StyleSheetType;
 					storeBlockedUrl = false;
 				}
-				else if (acceptHeader.contains(QByteArray("object")))
+				else if (hints & ObjectHint)
 				{
 					resourceType = NetworkManager::ObjectType;
 				}
@@ -633,7 +730,7 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 
 				if (result.isBlocked)
 				{
-					Console::addMessage(QCoreApplication::translate("main", "Request blocked with rule: %1").arg(result.rule), Console::NetworkCategory, Console::LogLevel, request.url().toString(), -1, (m_widget ? m_widget->getWindowIdentifier() : 0));
+					Console::addMessage(QCoreApplication::translate("main", "Request blocked with rule: %1"), QStringList(result.rule), Console::NetworkCategory, Console::LogLevel, request.url().toString(), -1, (m_widget ? m_widget->getWindowIdentifier() : 0));
 
 					if (storeBlockedUrl)
 					{
@@ -656,13 +753,15 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 		}
 	}
 
-	setPageInformation(WebWidget::RequestsStartedInformation, (m_pageInformation[WebWidget::RequestsStartedInformation].toULongLong() + 1));
+	++m_requestsStarted;
+
+	markPageInformationChanged(WebWidget::RequestsStartedInformation);
 
 	QNetworkRequest mutableRequest(request);
 
-	if (!m_canSendReferrer)
+	if (!m_canSendReferrer && request.hasRawHeader(QByteArray("Referer")))
 	{
-		mutableRequest.setRawHeader(QStringLiteral("Referer").toLatin1(), QByteArray());
+		mutableRequest.setRawHeader(QByteArray("Referer"), QByteArray());
 	}
 
 	if (operation == PostOperation && mutableRequest.header(QNetworkRequest::ContentTypeHeader).isNull())
@@ -674,15 +773,22 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 	{
 		mutableRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysCache);
 	}
-	else if (m_doNotTrackPolicy != NetworkManagerFactory::SkipTrackPolicy)
+	else if (!m_doNotTrackHeader.isEmpty() && request.rawHeader(QByteArray("DNT")) != m_doNotTrackHeader)
 	{
-		mutableRequest.setRawHeader(QStringLiteral("DNT").toLatin1(), ((m_doNotTrackPolicy == NetworkManagerFactory::DoNotAllowToTrackPolicy) ? QStringLiteral("1") : QStringLiteral("0")).toLatin1());
+		mutableRequest.setRawHeader(QByteArray("DNT"), m_doNotTrackHeader);
 	}
 
-	mutableRequest.setRawHeader(QStringLiteral("Accept-Language").toLatin1(), (m_acceptLanguage.isEmpty() ? NetworkManagerFactory::getAcceptLanguage().toLatin1() : m_acceptLanguage.toLatin1()));
-	mutableRequest.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
+	if (request.rawHeader(QByteArray("Accept-Language")) != m_acceptLanguageHeader)
+	{
+		mutableRequest.setRawHeader(QByteArray("Accept-Language"), m_acceptLanguageHeader);
+	}
 
-	setPageInformation(WebWidget::LoadingMessageInformation, tr("Sending request to %1…").arg(request.url().host()));
+	if (request.rawHeader(QByteArray("User-Agent")) != m_userAgentHeader)
+	{
+		mutableRequest.setRawHeader(QByteArray("User-Agent"), m_userAgentHeader);
+	}
+
+	setLoadingMessage(SendingRequestMessage, request.url().host());
 
 	QNetworkReply *reply(nullptr);
 
@@ -694,6 +800,10 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 	{
 		reply = new QtWebKitFtpListingNetworkReply(request, this);
 	}
+	else if (request.url().scheme() == QLatin1String("http") || request.url().scheme() == QLatin1String("https"))
+	{
+		reply = NetworkManagerFactory::getTransport(m_isPrivate)->createReply(this, m_cookieJarProxy, operation, mutableRequest, outgoingData);
+	}
 	else
 	{
 		reply = QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
@@ -702,6 +812,8 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 	if (!m_baseReply)
 	{
 		m_baseReply = reply;
+
+		PreconnectManager::notifyRequest(request.url());
 	}
 
 	if (m_securityState != InsecureState)
@@ -737,12 +849,31 @@ CookieJar* QtWebKitNetworkManager::getCookieJar()
 
 QVariant QtWebKitNetworkManager::getPageInformation(WebWidget::PageInformation key) const
 {
-	if (key == WebWidget::RequestsBlockedInformation)
-	{
-		return m_blockedRequests.count();
-	}
-
-	return m_pageInformation.value(key);
+	switch (key)
+	{
+		case WebWidget::DocumentLoadingProgressInformation:
+			return m_documentLoadingProgress;
+		case WebWidget::BytesReceivedInformation:
+			return m_bytesReceived;
+		case WebWidget::BytesTotalInformation:
+			return m_bytesTotal;
+		case WebWidget::RequestsBlockedInformation:
+			return m_blockedRequests.count();
+		case WebWidget::RequestsFinishedInformation:
+			return m_requestsFinished;
+		case WebWidget::RequestsStartedInformation:
+			return m_requestsStarted;
+		case WebWidget::LoadingSpeedInformation:
+			return m_loadingSpeed;
+		case WebWidget::LoadingFinishedInformation:
+			return m_loadingFinished;
+		case WebWidget::LoadingMessageInformation:
+			return getLoadingMessage();
+		default:
+			break;
+	}
+
+	return QVariant();
 }
 
 WebWidget::SslInformation QtWebKitNetworkManager::getSslInformation() const
@@ -755,6 +886,72 @@ QString QtWebKitNetworkManager::getUserAgent() const
 	return m_userAgent;
 }
 
+int QtWebKitNetworkManager::getResourceTypeHints(const QNetworkRequest &request)
+{
+	const QByteArray acceptHeader(request.rawHeader(QByteArray("Accept")));
+	const QString path(request.url().path());
+	const int extensionPosition(path.lastIndexOf(QLatin1Char('.')));
+	int hints((extensionPosition > path.lastIndexOf(QLatin1Char('/'))) ? m_extensionHints.value(path.mid(extensionPosition + 1), NoHint) : NoHint);
+	int position(0);
+
+	while (position < acceptHeader.length())
+	{
+		int end(acceptHeader.indexOf(',', position));
+
+		if (end < 0)
+		{
+			end = acceptHeader.length();
+		}
+
+		int typeEnd(acceptHeader.indexOf(';', position));
+
+		if (typeEnd < 0 || typeEnd > end)
+		{
+			typeEnd = end;
+		}
+
+		const QByteArray type(acceptHeader.mid(position, (typeEnd - position)).trimmed());
+
+		hints |= m_acceptHints.value(type, m_acceptHints.value(type.left(type.indexOf('/') + 1), NoHint));
+
+		if (type.contains("script/"))
+		{
+			hints |= ScriptHint;
+		}
+		else if (type.contains("object"))
+		{
+			hints |= ObjectHint;
+		}
+
+		position = (end + 1);
+	}
+
+	return hints;
+}
+
+QString QtWebKitNetworkManager::getLoadingMessage() const
+{
+	const QString host(m_loadingMessageHost.isEmpty() ? QLatin1String("localhost") : m_loadingMessageHost);
+
+	switch (m_loadingMessage)
+	{
+		case SendingRequestMessage:
+			return tr("Sending request to %1…").arg(host);
+		case ReceivingDataMessage:
+			return tr("Receiving data from %1…").arg(host);
+		case CompletedRequestMessage:
+			return tr("Completed request to %1").arg(host);
+		case WaitingForAuthenticationMessage:
+			return tr("Waiting for authentication…");
+		case LoadingFinishedMessage:
+			return tr("Loading finished");
+		default:
+			break;
+	}
+
+	return QString();
+}
+
 QStringList QtWebKitNetworkManager::getBlockedElements() const
 {
 	return m_blockedElements;
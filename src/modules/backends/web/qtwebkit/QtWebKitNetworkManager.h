@@ -57,13 +57,16 @@ protected:
 	void resetStatistics();
 	void registerTransfer(QNetworkReply *reply);
 	void updateLoadingSpeed();
+	void updatePageInformation();
 	void updateOptions(const QUrl &url);
-	void setPageInformation(WebWidget::PageInformation key, const QVariant &value);
+	void markPageInformationChanged(WebWidget::PageInformation key);
 	void setFormRequest(const QUrl &url);
 	void setWidget(QtWebKitWebWidget *widget);
 	QtWebKitNetworkManager *clone();
 	QNetworkReply* createRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData);
 	QString getUserAgent() const;
+	QString getLoadingMessage() const;
+	static int getResourceTypeHints(const QNetworkRequest &request);
 
 protected slots:
 	void downloadProgress(qint64 bytesReceived, qint64 bytesTotal);
@@ -83,12 +86,36 @@ private:
 		SecureState
 	};
 
+	enum LoadingMessage
+	{
+		NoLoadingMessage = 0,
+		SendingRequestMessage,
+		ReceivingDataMessage,
+		CompletedRequestMessage,
+		WaitingForAuthenticationMessage,
+		LoadingFinishedMessage
+	};
+
+	enum ResourceTypeHint
+	{
+		NoHint = 0,
+		DocumentHint = 1,
+		ImageHint = 2,
+		ScriptHint = 4,
+		StyleSheetHint = 8,
+		ObjectHint = 16
+	};
+
+	void setLoadingMessage(LoadingMessage message, const QString &host = QString());
+
 	QtWebKitWebWidget *m_widget;
 	CookieJar *m_cookieJar;
 	QtWebKitCookieJar *m_cookieJarProxy;
 	QNetworkReply *m_baseReply;
-	QString m_acceptLanguage;
 	QString m_userAgent;
+	QByteArray m_acceptLanguageHeader;
+	QByteArray m_doNotTrackHeader;
+	QByteArray m_userAgentHeader;
 	QUrl m_formRequestUrl;
 	WebWidget::SslInformation m_sslInformation;
 	QStringList m_blockedElements;
@@ -97,16 +124,28 @@ private:
 	QVector<int> m_contentBlockingProfiles;
 	QSet<QUrl> m_contentBlockingExceptions;
 	QHash<QNetworkReply*, QPair<qint64, bool> > m_replies;
-	QMap<WebWidget::PageInformation, QVariant> m_pageInformation;
+	QString m_loadingMessageHost;
+	QDateTime m_loadingFinished;
 	WindowsManager::ContentStates m_contentState;
-	NetworkManagerFactory::DoNotTrackPolicy m_doNotTrackPolicy;
+	qreal m_documentLoadingProgress;
+	quint64 m_bytesReceived;
+	quint64 m_bytesTotal;
 	qint64 m_bytesReceivedDifference;
+	qint64 m_loadingSpeed;
+	quint32 m_changedInformation;
 	SecurityState m_securityState;
+	LoadingMessage m_loadingMessage;
+	int m_requestsStarted;
+	int m_requestsFinished;
 	int m_loadingSpeedTimer;
+	int m_updateTimer;
 	bool m_areImagesEnabled;
 	bool m_canSendReferrer;
+	bool m_isPrivate;
 
 	static WebBackend *m_backend;
+	static QHash<QByteArray, int> m_acceptHints;
+	static QHash<QString, int> m_extensionHints;
 
 signals:
 	void pageInformationChanged(WebWidget::PageInformation, const QVariant &value);
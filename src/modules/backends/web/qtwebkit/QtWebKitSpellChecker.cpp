@@ -23,13 +23,22 @@
 #include "QtWebKitWebBackend.h"
 
 #include <QtCore/QTextBoundaryFinder>
+#include <QtCore/QTimerEvent>
+
+#define RESULTS_CACHE_SIZE 10000
+#define SUGGESTIONS_CACHE_SIZE 100
+#define SUGGESTIONS_DELAY 250
 
 namespace Meerkat
 {
 
 QtWebKitSpellChecker::QtWebKitSpellChecker() : QWebSpellChecker(),
-	m_speller(nullptr)
+	m_speller(nullptr),
+	m_suggestionsTimer(0)
 {
+	m_results.setMaxCost(RESULTS_CACHE_SIZE);
+	m_suggestions.setMaxCost(SUGGESTIONS_CACHE_SIZE);
+
 	setDictionary(QtWebKitWebBackend::getActiveDictionary());
 
 	connect(QtWebKitWebBackend::getInstance(), SIGNAL(activeDictionaryChanged(QString)), this, SLOT(setDictionary(QString)));
@@ -43,6 +52,27 @@ QtWebKitSpellChecker::~QtWebKitSpellChecker()
 	}
 }
 
+void QtWebKitSpellChecker::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_suggestionsTimer)
+	{
+		return;
+	}
+
+	killTimer(m_suggestionsTimer);
+
+	m_suggestionsTimer = 0;
+
+	const QString word(m_queuedSuggestion);
+
+	m_queuedSuggestion.clear();
+
+	if (m_speller && !word.isEmpty() && !m_suggestions.contains(word) && isMisspelled(word))
+	{
+		m_suggestions.insert(word, new QStringList(m_speller->suggest(word)));
+	}
+}
+
 void QtWebKitSpellChecker::toggleContinousSpellChecking()
 {
 }
@@ -79,10 +109,12 @@ void QtWebKitSpellChecker::checkSpellingOfString(const QString &word, int *missp
 
 			if (isValidWord(string))
 			{
-				if (m_speller->isMisspelled(string))
+				if (isMisspelled(string))
 				{
 					*misspellingLocation = start;
 					*misspellingLength = (end - start);
+
+					scheduleSuggestions(string);
 				}
 
 				return;
@@ -112,6 +144,9 @@ void QtWebKitSpellChecker::learnWord(const QString &word)
 	if (m_speller)
 	{
 		m_speller->addToPersonal(word);
+
+		m_results.remove(word);
+		m_suggestions.remove(word);
 	}
 }
 
@@ -120,6 +155,9 @@ void QtWebKitSpellChecker::ignoreWordInSpellDocument(const QString &word)
 	if (m_speller)
 	{
 		m_speller->addToSession(word);
+
+		m_results.remove(word);
+		m_suggestions.remove(word);
 	}
 }
 
@@ -127,30 +165,65 @@ void QtWebKitSpellChecker::guessesForWord(const QString &word, const QString &co
 {
 	Q_UNUSED(context);
 
-	if (m_speller)
+	if (!m_speller)
+	{
+		return;
+	}
+
+	QStringList *suggestions(m_suggestions.object(word));
+
+	if (suggestions)
+	{
+		guesses = *suggestions;
+	}
+	else
 	{
 		guesses = m_speller->suggest(word);
+
+		m_suggestions.insert(word, new QStringList(guesses));
 	}
 }
 
-void QtWebKitSpellChecker::setDictionary(const QString &dictionary)
+void QtWebKitSpellChecker::scheduleSuggestions(const QString &word)
 {
-	if (dictionary.isEmpty() && m_speller)
+	if (!m_speller || m_suggestions.contains(word))
 	{
-		delete m_speller;
+		return;
+	}
+
+	m_queuedSuggestion = word;
 
-		m_speller = nullptr;
+	if (m_suggestionsTimer != 0)
+	{
+		killTimer(m_suggestionsTimer);
 	}
-	else if (!dictionary.isEmpty())
+
+	m_suggestionsTimer = startTimer(SUGGESTIONS_DELAY);
+}
+
+void QtWebKitSpellChecker::setDictionary(const QString &dictionary)
+{
+	m_results.clear();
+	m_suggestions.clear();
+	m_queuedSuggestion.clear();
+
+	if (dictionary.isEmpty())
 	{
 		if (m_speller)
 		{
-			m_speller->setLanguage(dictionary);
-		}
-		else
-		{
-			m_speller = new Sonnet::Speller(dictionary);
+			delete m_speller;
+
+			m_speller = nullptr;
 		}
+
+	}
+	else if (m_speller)
+	{
+		m_speller->setLanguage(dictionary);
+	}
+	else
+	{
+		m_speller = new Sonnet::Speller(dictionary);
 	}
 }
 
@@ -171,6 +244,22 @@ bool QtWebKitSpellChecker::isGrammarCheckingEnabled()
 	return false;
 }
 
+bool QtWebKitSpellChecker::isMisspelled(const QString &word)
+{
+	bool *result(m_results.object(word));
+
+	if (result)
+	{
+		return *result;
+	}
+
+	const bool isMisspelled(m_speller->isMisspelled(word));
+
+	m_results.insert(word, new bool(isMisspelled));
+
+	return isMisspelled;
+}
+
 bool QtWebKitSpellChecker::isValidWord(const QString &string)
 {
 	if (string.isEmpty() || (string.length() == 1 && !string.at(0).isLetter()))
@@ -23,6 +23,8 @@
 #include "qwebkitplatformplugin.h"
 #include "../../../../../3rdparty/sonnet/src/core/speller.h"
 
+#include <QtCore/QCache>
+
 namespace Meerkat
 {
 
@@ -46,6 +48,9 @@ public:
 	bool isGrammarCheckingEnabled();
 
 protected:
+	void timerEvent(QTimerEvent *event);
+	void scheduleSuggestions(const QString &word);
+	bool isMisspelled(const QString &word);
 	static bool isValidWord(const QString &string);
 
 protected slots:
@@ -53,6 +58,10 @@ protected slots:
 
 private:
 	Sonnet::Speller *m_speller;
+	QString m_queuedSuggestion;
+	QCache<QString, bool> m_results;
+	QCache<QString, QStringList> m_suggestions;
+	int m_suggestionsTimer;
 };
 
 }
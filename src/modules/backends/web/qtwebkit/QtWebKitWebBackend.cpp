@@ -29,6 +29,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QTextStream>
 #include <QtWebKit/QWebHistoryInterface>
 #include <QtWebKit/QWebSettings>
 
@@ -41,13 +42,19 @@ QMap<QString, QString> QtWebKitWebBackend::m_userAgentComponents;
 QMap<QString, QString> QtWebKitWebBackend::m_userAgents;
 int QtWebKitWebBackend::m_enableMediaOption(-1);
 int QtWebKitWebBackend::m_enableMediaSourceOption(-1);
+int QtWebKitWebBackend::m_thumbnailsConcurrencyLimitOption(-1);
+int QtWebKitWebBackend::m_thumbnailsTimeoutOption(-1);
 
 QtWebKitWebBackend::QtWebKitWebBackend(QObject *parent) : WebBackend(parent),
+	m_thumbnailsWaitTime(0),
+	m_thumbnailsRenderTime(0),
 	m_isInitialized(false)
 {
 	m_instance = this;
 	m_enableMediaOption = SettingsManager::registerOption(QLatin1String("QtWebKitBackend/EnableMedia"), true, SettingsManager::BooleanType);
 	m_enableMediaSourceOption = SettingsManager::registerOption(QLatin1String("QtWebKitBackend/EnableMediaSource"), false, SettingsManager::BooleanType);
+	m_thumbnailsConcurrencyLimitOption = SettingsManager::registerOption(QLatin1String("QtWebKitBackend/ThumbnailsConcurrencyLimit"), 3, SettingsManager::IntegerType);
+	m_thumbnailsTimeoutOption = SettingsManager::registerOption(QLatin1String("QtWebKitBackend/ThumbnailsTimeout"), 30, SettingsManager::IntegerType);
 
 	const QString cachePath(SessionsManager::getCachePath());
 
@@ -74,8 +81,40 @@ QtWebKitWebBackend::QtWebKitWebBackend(QObject *parent) : WebBackend(parent),
 QtWebKitWebBackend::~QtWebKitWebBackend()
 {
 	qDeleteAll(m_thumbnailRequests.keys());
+	qDeleteAll(m_thumbnailPages);
 
 	m_thumbnailRequests.clear();
+	m_thumbnailPages.clear();
+}
+
+void QtWebKitWebBackend::timerEvent(QTimerEvent *event)
+{
+	QHash<QtWebKitPage*, ThumbnailRequest>::iterator iterator;
+
+	for (iterator = m_thumbnailRequests.begin(); iterator != m_thumbnailRequests.end(); ++iterator)
+	{
+		if (iterator.value().timeoutTimer == event->timerId())
+		{
+			QtWebKitPage *page(iterator.key());
+			const QUrl url(iterator.value().url);
+
+			killTimer(event->timerId());
+
+			m_thumbnailRequests.erase(iterator);
+
+			++m_thumbnailStatistics.timedOutRequests;
+
+			releaseThumbnailPage(page);
+
+			emit thumbnailAvailable(url, QImage(), QString());
+
+			processThumbnailsQueue();
+
+			return;
+		}
+	}
+
+	WebBackend::timerEvent(event);
 }
 
 void QtWebKitWebBackend::optionChanged(int identifier)
@@ -120,16 +159,20 @@ void QtWebKitWebBackend::pageLoaded(bool success)
 {
 	QtWebKitPage *page(qobject_cast<QtWebKitPage*>(sender()));
 
-	if (!page)
+	if (!page || !m_thumbnailRequests.contains(page))
 	{
 		return;
 	}
 
+	const ThumbnailRequest request(m_thumbnailRequests.take(page));
+	QImage image;
+	QString title;
+
+	killTimer(request.timeoutTimer);
+
 	if (success)
 	{
-		QPixmap pixmap;
-
-		if (!m_thumbnailRequests[page].second.isEmpty())
+		if (!request.size.isEmpty())
 		{
 			QSize contentsSize(page->mainFrame()->contentsSize());
 
@@ -140,30 +183,83 @@ void QtWebKitWebBackend::pageLoaded(bool success)
 				contentsSize.setWidth(2000);
 			}
 
-			contentsSize.setHeight(m_thumbnailRequests[page].second.height() * (qreal(contentsSize.width()) / m_thumbnailRequests[page].second.width()));
+			contentsSize.setHeight(request.size.height() * (qreal(contentsSize.width()) / request.size.width()));
 
-			pixmap = QPixmap(contentsSize);
-			pixmap.fill(Qt::white);
+			image = QImage(contentsSize, QImage::Format_RGB32);
+			image.fill(Qt::white);
 
-			QPainter painter(&pixmap);
+			QPainter painter(&image);
 
 			page->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion(QRect(QPoint(0, 0), contentsSize)));
 
 			painter.end();
-
-			pixmap = pixmap.scaled(m_thumbnailRequests[page].second, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 		}
 
-		emit thumbnailAvailable(m_thumbnailRequests[page].first, pixmap, page->mainFrame()->title());
+		title = page->mainFrame()->title();
+
+		++m_thumbnailStatistics.completedRequests;
+
+		m_thumbnailsWaitTime += request.waitTime;
+		m_thumbnailsRenderTime += (request.timer.elapsed() - request.waitTime);
 	}
 	else
 	{
-		emit thumbnailAvailable(m_thumbnailRequests[page].first, QPixmap(), QString());
+		++m_thumbnailStatistics.failedRequests;
 	}
 
-	m_thumbnailRequests.remove(page);
+	releaseThumbnailPage(page);
 
-	page->deleteLater();
+	emit thumbnailAvailable(request.url, image, title);
+
+	processThumbnailsQueue();
+}
+
+void QtWebKitWebBackend::processThumbnailsQueue()
+{
+	const int limit(qMax(1, SettingsManager::getValue(m_thumbnailsConcurrencyLimitOption).toInt()));
+	const int timeout(qMax(1, SettingsManager::getValue(m_thumbnailsTimeoutOption).toInt()));
+
+	while (!m_thumbnailsQueue.isEmpty() && m_thumbnailRequests.count() < limit)
+	{
+		ThumbnailRequest request(m_thumbnailsQueue.takeFirst());
+		QtWebKitPage *page(nullptr);
+
+		if (m_thumbnailPages.isEmpty())
+		{
+			page = new QtWebKitPage();
+			page->setParent(this);
+			page->settings()->setAttribute(QWebSettings::JavaEnabled, false);
+			page->settings()->setAttribute(QWebSettings::JavascriptEnabled, false);
+			page->settings()->setAttribute(QWebSettings::PluginsEnabled, false);
+
+			connect(page, SIGNAL(loadFinished(bool)), this, SLOT(pageLoaded(bool)));
+		}
+		else
+		{
+			page = m_thumbnailPages.takeLast();
+		}
+
+		request.waitTime = request.timer.elapsed();
+		request.timeoutTimer = startTimer(timeout * 1000);
+
+		m_thumbnailRequests[page] = request;
+
+		page->mainFrame()->setUrl(request.url);
+	}
+}
+
+void QtWebKitWebBackend::releaseThumbnailPage(QtWebKitPage *page)
+{
+	page->triggerAction(QWebPage::Stop);
+
+	if (m_thumbnailPages.count() < qMax(1, SettingsManager::getValue(m_thumbnailsConcurrencyLimitOption).toInt()))
+	{
+		m_thumbnailPages.append(page);
+	}
+	else
+	{
+		page->deleteLater();
+	}
 }
 
 void QtWebKitWebBackend::setActiveWidget(WebWidget *widget)
@@ -286,11 +382,50 @@ QString QtWebKitWebBackend::getActiveDictionary()
 	return QString();
 }
 
+QString QtWebKitWebBackend::getReport() const
+{
+	const ThumbnailStatistics statistics(getThumbnailStatistics());
+	const QList<QPair<QString, qint64> > values({qMakePair(QString(QLatin1String("Queued")), qint64(statistics.queueDepth)), qMakePair(QString(QLatin1String("Active")), qint64(statistics.activeRequests)), qMakePair(QString(QLatin1String("Completed")), qint64(statistics.completedRequests)), qMakePair(QString(QLatin1String("Failed")), qint64(statistics.failedRequests)), qMakePair(QString(QLatin1String("Timed Out")), qint64(statistics.timedOutRequests)), qMakePair(QString(QLatin1String("Average Wait (ms)")), statistics.averageWaitTime), qMakePair(QString(QLatin1String("Average Render (ms)")), statistics.averageRenderTime)});
+	QString report;
+	QTextStream stream(&report);
+	stream.setFieldAlignment(QTextStream::AlignLeft);
+	stream << QLatin1String("Thumbnails:\n");
+
+	for (int i = 0; i < values.count(); ++i)
+	{
+		stream << QLatin1Char('\t');
+		stream.setFieldWidth(20);
+		stream << values.at(i).first;
+		stream << values.at(i).second;
+		stream.setFieldWidth(0);
+		stream << QLatin1Char('\n');
+	}
+
+	stream << QLatin1Char('\n');
+
+	return report;
+}
+
 QList<SpellCheckManager::DictionaryInformation> QtWebKitWebBackend::getDictionaries() const
 {
 	return SpellCheckManager::getDictionaries();
 }
 
+QtWebKitWebBackend::ThumbnailStatistics QtWebKitWebBackend::getThumbnailStatistics() const
+{
+	ThumbnailStatistics statistics(m_thumbnailStatistics);
+	statistics.queueDepth = m_thumbnailsQueue.count();
+	statistics.activeRequests = m_thumbnailRequests.count();
+
+	if (statistics.completedRequests > 0)
+	{
+		statistics.averageWaitTime = (m_thumbnailsWaitTime / statistics.completedRequests);
+		statistics.averageRenderTime = (m_thumbnailsRenderTime / statistics.completedRequests);
+	}
+
+	return statistics;
+}
+
 int QtWebKitWebBackend::getOptionIdentifier(QtWebKitWebBackend::OptionIdentifier identifier)
 {
 	switch (identifier)
@@ -299,6 +434,10 @@ int QtWebKitWebBackend::getOptionIdentifier(QtWebKitWebBackend::OptionIdentifier
 			return m_enableMediaOption;
 		case QtWebKitBackend_EnableMediaSourceOption:
 			return m_enableMediaSourceOption;
+		case QtWebKitBackend_ThumbnailsConcurrencyLimitOption:
+			return m_thumbnailsConcurrencyLimitOption;
+		case QtWebKitBackend_ThumbnailsTimeoutOption:
+			return m_thumbnailsTimeoutOption;
 		default:
 			return -1;
 	}
@@ -306,19 +445,51 @@ int QtWebKitWebBackend::getOptionIdentifier(QtWebKitWebBackend::OptionIdentifier
 	return -1;
 }
 
-bool QtWebKitWebBackend::requestThumbnail(const QUrl &url, const QSize &size)
+bool QtWebKitWebBackend::requestThumbnail(const QUrl &url, const QSize &size, bool hasPriority)
 {
-	QtWebKitPage *page(new QtWebKitPage());
+	QHash<QtWebKitPage*, ThumbnailRequest>::const_iterator iterator;
 
-	m_thumbnailRequests[page] = qMakePair(url, size);
+	for (iterator = m_thumbnailRequests.constBegin(); iterator != m_thumbnailRequests.constEnd(); ++iterator)
+	{
+		if (iterator.value().url == url)
+		{
+			return true;
+		}
+	}
 
-	connect(page, SIGNAL(loadFinished(bool)), this, SLOT(pageLoaded(bool)));
+	for (int i = 0; i < m_thumbnailsQueue.count(); ++i)
+	{
+		if (m_thumbnailsQueue.at(i).url == url)
+		{
+			if (!size.isEmpty())
+			{
+				m_thumbnailsQueue[i].size = size;
+			}
+
+			if (hasPriority && i > 0)
+			{
+				m_thumbnailsQueue.move(i, 0);
+			}
+
+			return true;
+		}
+	}
+
+	ThumbnailRequest request;
+	request.url = url;
+	request.size = size;
+	request.timer.start();
+
+	if (hasPriority)
+	{
+		m_thumbnailsQueue.prepend(request);
+	}
+	else
+	{
+		m_thumbnailsQueue.append(request);
+	}
 
-	page->setParent(this);
-	page->settings()->setAttribute(QWebSettings::JavaEnabled, false);
-	page->settings()->setAttribute(QWebSettings::JavascriptEnabled, false);
-	page->settings()->setAttribute(QWebSettings::PluginsEnabled, false);
-	page->mainFrame()->setUrl(url);
+	processThumbnailsQueue();
 
 	return true;
 }
@@ -22,6 +22,8 @@
 
 #include "../../../../core/WebBackend.h"
 
+#include <QtCore/QElapsedTimer>
+
 namespace Meerkat
 {
 
@@ -36,7 +38,20 @@ public:
 	enum OptionIdentifier
 	{
 		QtWebKitBackend_EnableMediaOption = 0,
-		QtWebKitBackend_EnableMediaSourceOption
+		QtWebKitBackend_EnableMediaSourceOption,
+		QtWebKitBackend_ThumbnailsConcurrencyLimitOption,
+		QtWebKitBackend_ThumbnailsTimeoutOption
+	};
+
+	struct ThumbnailStatistics
+	{
+		int queueDepth = 0;
+		int activeRequests = 0;
+		int completedRequests = 0;
+		int failedRequests = 0;
+		int timedOutRequests = 0;
+		qint64 averageWaitTime = 0;
+		qint64 averageRenderTime = 0;
 	};
 
 	explicit QtWebKitWebBackend(QObject *parent = nullptr);
@@ -49,13 +64,27 @@ public:
 	QString getEngineVersion() const;
 	QString getSslVersion() const;
 	QString getUserAgent(const QString &pattern = QString()) const;
+	QString getReport() const;
 	QUrl getHomePage() const;
 	QIcon getIcon() const;
 	QList<SpellCheckManager::DictionaryInformation> getDictionaries() const;
+	ThumbnailStatistics getThumbnailStatistics() const;
 	static int getOptionIdentifier(OptionIdentifier identifier);
-	bool requestThumbnail(const QUrl &url, const QSize &size);
+	bool requestThumbnail(const QUrl &url, const QSize &size, bool hasPriority = false);
 
 protected:
+	struct ThumbnailRequest
+	{
+		QUrl url;
+		QSize size;
+		QElapsedTimer timer;
+		qint64 waitTime = 0;
+		int timeoutTimer = 0;
+	};
+
+	void timerEvent(QTimerEvent *event);
+	void processThumbnailsQueue();
+	void releaseThumbnailPage(QtWebKitPage *page);
 	static QtWebKitWebBackend* getInstance();
 	static QString getActiveDictionary();
 
@@ -65,7 +94,12 @@ protected slots:
 	void setActiveWidget(WebWidget *widget);
 
 private:
-	QHash<QtWebKitPage*, QPair<QUrl, QSize> > m_thumbnailRequests;
+	QList<ThumbnailRequest> m_thumbnailsQueue;
+	QList<QtWebKitPage*> m_thumbnailPages;
+	QHash<QtWebKitPage*, ThumbnailRequest> m_thumbnailRequests;
+	ThumbnailStatistics m_thumbnailStatistics;
+	qint64 m_thumbnailsWaitTime;
+	qint64 m_thumbnailsRenderTime;
 	bool m_isInitialized;
 
 	static QtWebKitWebBackend* m_instance;
@@ -74,6 +108,8 @@ private:
 	static QMap<QString, QString> m_userAgents;
 	static int m_enableMediaOption;
 	static int m_enableMediaSourceOption;
+	static int m_thumbnailsConcurrencyLimitOption;
+	static int m_thumbnailsTimeoutOption;
 
 signals:
 	void activeDictionaryChanged(const QString &dictionary);
@@ -37,10 +37,12 @@
 #include "../../../../core/NetworkManager.h"
 #include "../../../../core/NetworkManagerFactory.h"
 #include "../../../../core/NotesManager.h"
+#include "../../../../core/PreconnectManager.h"
 #include "../../../../core/SearchEnginesManager.h"
 #include "../../../../core/SessionsManager.h"
 #include "../../../../core/SettingsManager.h"
 #include "../../../../core/ThemesManager.h"
+#include "../../../../core/ThumbnailsManager.h"
 #include "../../../../core/TransfersManager.h"
 #include "../../../../core/UserScript.h"
 #include "../../../../core/Utils.h"
@@ -87,7 +89,8 @@ QtWebKitWebWidget::QtWebKitWebWidget(bool isPrivate, WebBackend *backend, QtWebK
 	m_canLoadPlugins(false),
 	m_isAudioMuted(false),
 	m_isTyped(false),
-	m_isNavigating(false)
+	m_isNavigating(false),
+	m_isThumbnailRequested(false)
 {
 	m_splitter->addWidget(m_webView);
 	m_splitter->setChildrenCollapsible(false);
@@ -139,6 +142,8 @@ QtWebKitWebWidget::QtWebKitWebWidget(bool isPrivate, WebBackend *backend, QtWebK
 
 	connect(BookmarksManager::getModel(), SIGNAL(modelModified()), this, SLOT(updateBookmarkActions()));
 	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int,QVariant)));
+	connect(ThumbnailsManager::getInstance(), SIGNAL(thumbnailAvailable(QUrl,QSize)), this, SLOT(handleThumbnailAvailable(QUrl,QSize)));
+	connect(ThumbnailsManager::getInstance(), SIGNAL(thumbnailFailed(QUrl,QSize)), this, SLOT(handleThumbnailFailed(QUrl,QSize)));
 	connect(m_page, SIGNAL(aboutToNavigate(QUrl,QWebFrame*,QWebPage::NavigationType)), this, SLOT(navigating(QUrl,QWebFrame*,QWebPage::NavigationType)));
 	connect(m_page, SIGNAL(requestedNewWindow(WebWidget*,WindowsManager::OpenHints)), this, SIGNAL(requestedNewWindow(WebWidget*,WindowsManager::OpenHints)));
 	connect(m_page, SIGNAL(requestedPopupWindow(QUrl,QUrl)), this, SIGNAL(requestedPopupWindow(QUrl,QUrl)));
@@ -305,6 +310,7 @@ void QtWebKitWebWidget::pageLoadStarted()
 	m_canLoadPlugins = (getOption(SettingsManager::Browser_EnablePluginsOption, getUrl()).toString() == QLatin1String("enabled"));
 	m_loadingState = WindowsManager::OngoingLoadingState;
 	m_thumbnail = QPixmap();
+	m_isThumbnailRequested = false;
 
 	updateNavigationActions();
 	setStatusMessage(QString());
@@ -332,6 +338,7 @@ void QtWebKitWebWidget::pageLoadFinished()
 
 	m_loadingState = WindowsManager::FinishedLoadingState;
 	m_thumbnail = QPixmap();
+	m_isThumbnailRequested = false;
 
 	updateNavigationActions();
 	handleHistory();
@@ -527,6 +534,11 @@ void QtWebKitWebWidget::restoreState(QWebFrame *frame)
 void QtWebKitWebWidget::linkHovered(const QString &link)
 {
 	setStatusMessage(link, true);
+
+	if (!link.isEmpty() && !isPrivate() && PreconnectManager::isEnabled())
+	{
+		PreconnectManager::preconnect(QUrl(link), getUrl(), ContentBlockingManager::getProfileList(getOption(SettingsManager::ContentBlocking_ProfilesOption, getUrl()).toStringList()));
+	}
 }
 
 void QtWebKitWebWidget::clearPluginToken()
@@ -725,6 +737,25 @@ void QtWebKitWebWidget::handlePermissionCancel(QWebFrame *frame, QWebPage::Featu
 	notifyPermissionRequested(frame, feature, true);
 }
 
+void QtWebKitWebWidget::handleThumbnailAvailable(const QUrl &url, const QSize &size)
+{
+	if (!m_isThumbnailRequested || size != QSize(260, 170) || url != getUrl())
+	{
+		return;
+	}
+
+	m_thumbnail = ThumbnailsManager::getThumbnail(url, size, devicePixelRatio(), isPrivate());
+	m_isThumbnailRequested = false;
+}
+
+void QtWebKitWebWidget::handleThumbnailFailed(const QUrl &url, const QSize &size)
+{
+	if (m_isThumbnailRequested && size == QSize(260, 170) && url == getUrl())
+	{
+		m_isThumbnailRequested = false;
+	}
+}
+
 void QtWebKitWebWidget::openFormRequest(const QUrl &url, QNetworkAccessManager::Operation operation, QIODevice *outgoingData)
 {
 	m_webView->stop();
@@ -2148,6 +2179,12 @@ QPixmap QtWebKitWebWidget::getThumbnail()
 	}
 
 	const QSize thumbnailSize(QSize(260, 170));
+
+	if (m_isThumbnailRequested)
+	{
+		return ThumbnailsManager::getThumbnail(getUrl(), thumbnailSize, devicePixelRatio(), isPrivate());
+	}
+
 	const QSize oldViewportSize(m_webView->page()->viewportSize());
 	const QPoint position(m_webView->page()->mainFrame()->scrollPosition());
 	const qreal zoom(m_webView->page()->mainFrame()->zoomFactor());
@@ -2166,10 +2203,10 @@ QPixmap QtWebKitWebWidget::getThumbnail()
 
 	contentsSize.setHeight(thumbnailSize.height() * (qreal(contentsSize.width()) / thumbnailSize.width()));
 
-	QPixmap pixmap(contentsSize);
-	pixmap.fill(Qt::white);
+	QImage image(contentsSize, QImage::Format_RGB32);
+	image.fill(Qt::white);
 
-	QPainter painter(&pixmap);
+	QPainter painter(&image);
 
 	m_webView->page()->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion(QRect(QPoint(0, 0), contentsSize)));
 	m_webView->page()->mainFrame()->setZoomFactor(zoom);
@@ -2179,14 +2216,13 @@ QPixmap QtWebKitWebWidget::getThumbnail()
 
 	painter.end();
 
-	pixmap = pixmap.scaled((thumbnailSize * devicePixelRatio()), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-	pixmap.setDevicePixelRatio(devicePixelRatio());
-
 	newView->deleteLater();
 
-	m_thumbnail = pixmap;
+	m_isThumbnailRequested = true;
+
+	ThumbnailsManager::storeThumbnail(getUrl(), image, thumbnailSize, devicePixelRatio(), isPrivate());
 
-	return pixmap;
+	return ThumbnailsManager::getThumbnail(getUrl(), thumbnailSize, devicePixelRatio(), isPrivate());
 }
 
 QPoint QtWebKitWebWidget::getScrollPosition() const
@@ -159,6 +159,8 @@ protected slots:
 	void handleWindowCloseRequest();
 	void handlePermissionRequest(QWebFrame *frame, QWebPage::Feature feature);
 	void handlePermissionCancel(QWebFrame *frame, QWebPage::Feature feature);
+	void handleThumbnailAvailable(const QUrl &url, const QSize &size);
+	void handleThumbnailFailed(const QUrl &url, const QSize &size);
 	void notifyTitleChanged();
 	void notifyUrlChanged(const QUrl &url);
 	void notifyIconChanged();
@@ -190,6 +192,7 @@ private:
 	bool m_isAudioMuted;
 	bool m_isTyped;
 	bool m_isNavigating;
+	bool m_isThumbnailRequested;
 
 signals:
 	void widgetActivated(WebWidget *widget);
@@ -22,18 +22,18 @@
 #include "../../../core/BookmarksManager.h"
 
 #include <QtCore/QDir>
-#ifdef MEERKAT_ENABLE_QTWEBKIT
-//TODO QtWebKit should not be used directly
-#include <QtWebKitWidgets/QWebPage>
-#include <QtWebKitWidgets/QWebFrame>
-#include <QtWebKit/QWebElementCollection>
-#endif
+#include <QtCore/QTextCodec>
+
+#define BUFFER_SIZE 65536
+#define PROGRESS_INTERVAL 1000
 
 namespace Meerkat
 {
 
 HtmlBookmarksImporter::HtmlBookmarksImporter(QObject *parent) : BookmarksImporter(parent),
-	m_optionsWidget(nullptr)
+	m_optionsWidget(nullptr),
+	m_currentBookmark(nullptr),
+	m_position(0)
 {
 }
 
@@ -45,96 +45,49 @@ HtmlBookmarksImporter::~HtmlBookmarksImporter()
 	}
 }
 
-#ifdef MEERKAT_ENABLE_QTWEBKIT
-void HtmlBookmarksImporter::processElement(const QWebElement &element)
+void HtmlBookmarksImporter::addBookmark(BookmarksModel::BookmarkType type, const QHash<QString, QString> &attributes, const QString &title)
 {
-	const QString tagName(element.tagName().toLower());
-	BookmarksModel::BookmarkType type(BookmarksModel::UnknownBookmark);
+	const QUrl url((type == BookmarksModel::UrlBookmark) ? QUrl(decodeEntities(attributes.value(QLatin1String("HREF")))) : QUrl());
 
-	if (tagName == QLatin1String("h3"))
+	if (type == BookmarksModel::UrlBookmark && !allowDuplicates() && BookmarksManager::hasBookmark(url))
 	{
-		type = BookmarksModel::FolderBookmark;
+		m_currentBookmark = nullptr;
+
+		return;
 	}
-	else if (tagName == QLatin1String("a"))
+
+	m_currentBookmark = BookmarksManager::addBookmark(type, url, decodeEntities(title).simplified(), getCurrentFolder());
+
+	if (!m_currentBookmark)
 	{
-		type = BookmarksModel::UrlBookmark;
+		return;
 	}
-	else if (tagName == QLatin1String("hr"))
+
+	const QString keyword(decodeEntities(attributes.value(QLatin1String("SHORTCUTURL"))));
+
+	if (!keyword.isEmpty() && !BookmarksManager::hasKeyword(keyword))
 	{
-		type = BookmarksModel::SeparatorBookmark;
+		m_currentBookmark->setData(keyword, BookmarksModel::KeywordRole);
 	}
 
-	if (type == BookmarksModel::FolderBookmark || type == BookmarksModel::UrlBookmark)
+	if (attributes.contains(QLatin1String("ADD_DATE")))
 	{
-		const QString keyword(element.attribute(QLatin1String("SHORTCUTURL")));
-		const QUrl url((type == BookmarksModel::UrlBookmark) ? element.attribute(QLatin1String("HREF")) : QUrl());
-
-		if (type == BookmarksModel::UrlBookmark && !allowDuplicates() && BookmarksManager::hasBookmark(url))
-		{
-			return;
-		}
-
-		BookmarksItem *bookmark(BookmarksManager::addBookmark(type, url, element.toPlainText(), getCurrentFolder()));
-
-		if (type == BookmarksModel::FolderBookmark)
-		{
-			setCurrentFolder(bookmark);
-		}
-
-		if (!keyword.isEmpty() && !BookmarksManager::hasKeyword(keyword))
-		{
-			bookmark->setData(keyword, BookmarksModel::KeywordRole);
-		}
-
-		if (!element.attribute(QLatin1String("ADD_DATE")).isEmpty())
-		{
-			const QDateTime time(QDateTime::fromTime_t(element.attribute(QLatin1String("ADD_DATE")).toUInt()));
-
-			bookmark->setData(time, BookmarksModel::TimeAddedRole);
-			bookmark->setData(time, BookmarksModel::TimeModifiedRole);
-		}
-
-		if (element.parent().nextSibling().tagName().toLower() == QLatin1String("dd"))
-		{
-			bookmark->setData(element.parent().nextSibling().toPlainText(), BookmarksModel::DescriptionRole);
-		}
-
-		if (!element.attribute(QLatin1String("ADD_DATE")).isEmpty())
-		{
-			bookmark->setData(QDateTime::fromTime_t(element.attribute(QLatin1String("ADD_DATE")).toUInt()), BookmarksModel::TimeAddedRole);
-		}
-
-		if (!element.attribute(QLatin1String("LAST_MODIFIED")).isEmpty())
-		{
-			bookmark->setData(QDateTime::fromTime_t(element.attribute(QLatin1String("LAST_MODIFIED")).toUInt()), BookmarksModel::TimeModifiedRole);
-		}
+		const QDateTime time(QDateTime::fromTime_t(attributes.value(QLatin1String("ADD_DATE")).toUInt()));
 
-		if (!element.attribute(QLatin1String("LAST_VISITED")).isEmpty())
-		{
-			bookmark->setData(QDateTime::fromTime_t(element.attribute(QLatin1String("LAST_VISITED")).toUInt()), BookmarksModel::TimeVisitedRole);
-		}
+		m_currentBookmark->setData(time, BookmarksModel::TimeAddedRole);
+		m_currentBookmark->setData(time, BookmarksModel::TimeModifiedRole);
 	}
-	else if (type == BookmarksModel::SeparatorBookmark)
-	{
-		BookmarksManager::addBookmark(BookmarksModel::SeparatorBookmark, QUrl(), QString(), getCurrentFolder());
-	}
-
-	const QWebElementCollection descendants(element.findAll(QLatin1String("*")));
 
-	for (int i = 0; i < descendants.count(); ++i)
+	if (attributes.contains(QLatin1String("LAST_MODIFIED")))
 	{
-		if (descendants.at(i).parent() == element)
-		{
-			processElement(descendants.at(i));
-		}
+		m_currentBookmark->setData(QDateTime::fromTime_t(attributes.value(QLatin1String("LAST_MODIFIED")).toUInt()), BookmarksModel::TimeModifiedRole);
 	}
 
-	if (element.tagName().toLower() == QLatin1String("dl"))
+	if (attributes.contains(QLatin1String("LAST_VISITED")))
 	{
-		goToParent();
+		m_currentBookmark->setData(QDateTime::fromTime_t(attributes.value(QLatin1String("LAST_VISITED")).toUInt()), BookmarksModel::TimeVisitedRole);
 	}
 }
-#endif
 
 QWidget* HtmlBookmarksImporter::getOptionsWidget()
 {
@@ -191,9 +144,252 @@ QStringList HtmlBookmarksImporter::getFileFilters() const
 	return QStringList(tr("HTML files (*.htm *.html)"));
 }
 
+QString HtmlBookmarksImporter::decodeEntities(const QString &text)
+{
+	if (!text.contains(QLatin1Char('&')))
+	{
+		return text;
+	}
+
+	QString result;
+	result.reserve(text.length());
+
+	for (int i = 0; i < text.length(); ++i)
+	{
+		const int end((text.at(i) == QLatin1Char('&')) ? text.indexOf(QLatin1Char(';'), i) : -1);
+
+		if (end < 0 || (end - i) > 10)
+		{
+			result.append(text.at(i));
+
+			continue;
+		}
+
+		const QString entity(text.mid((i + 1), (end - i - 1)));
+		uint character(0);
+
+		if (entity.startsWith(QLatin1String("#x"), Qt::CaseInsensitive))
+		{
+			character = entity.mid(2).toUInt(nullptr, 16);
+		}
+		else if (entity.startsWith(QLatin1Char('#')))
+		{
+			character = entity.mid(1).toUInt();
+		}
+		else if (entity == QLatin1String("amp"))
+		{
+			character = '&';
+		}
+		else if (entity == QLatin1String("lt"))
+		{
+			character = '<';
+		}
+		else if (entity == QLatin1String("gt"))
+		{
+			character = '>';
+		}
+		else if (entity == QLatin1String("quot"))
+		{
+			character = '"';
+		}
+		else if (entity == QLatin1String("apos"))
+		{
+			character = '\'';
+		}
+		else if (entity == QLatin1String("nbsp"))
+		{
+			character = 0xA0;
+		}
+
+		if (character == 0)
+		{
+			result.append(text.at(i));
+
+			continue;
+		}
+
+		if (QChar::requiresSurrogates(character))
+		{
+			result.append(QChar(QChar::highSurrogate(character)));
+			result.append(QChar(QChar::lowSurrogate(character)));
+		}
+		else
+		{
+			result.append(QChar(character));
+		}
+
+		i = end;
+	}
+
+	return result;
+}
+
+QHash<QString, QString> HtmlBookmarksImporter::parseAttributes(const QString &tag, int position)
+{
+	QHash<QString, QString> attributes;
+
+	while (position < tag.length())
+	{
+		while (position < tag.length() && tag.at(position).isSpace())
+		{
+			++position;
+		}
+
+		const int nameStart(position);
+
+		while (position < tag.length() && !tag.at(position).isSpace() && tag.at(position) != QLatin1Char('=') && tag.at(position) != QLatin1Char('/'))
+		{
+			++position;
+		}
+
+		const QString name(tag.mid(nameStart, (position - nameStart)).toUpper());
+
+		while (position < tag.length() && tag.at(position).isSpace())
+		{
+			++position;
+		}
+
+		if (position >= tag.length() || tag.at(position) != QLatin1Char('='))
+		{
+			if (!name.isEmpty())
+			{
+				attributes[name] = QString();
+			}
+			else
+			{
+				++position;
+			}
+
+			continue;
+		}
+
+		++position;
+
+		while (position < tag.length() && tag.at(position).isSpace())
+		{
+			++position;
+		}
+
+		if (position < tag.length() && (tag.at(position) == QLatin1Char('"') || tag.at(position) == QLatin1Char('\'')))
+		{
+			const QChar quote(tag.at(position));
+			const int valueStart(position + 1);
+			int valueEnd(tag.indexOf(quote, valueStart));
+
+			if (valueEnd < 0)
+			{
+				valueEnd = tag.length();
+			}
+
+			attributes[name] = tag.mid(valueStart, (valueEnd - valueStart));
+
+			position = (valueEnd + 1);
+		}
+		else
+		{
+			const int valueStart(position);
+
+			while (position < tag.length() && !tag.at(position).isSpace())
+			{
+				++position;
+			}
+
+			attributes[name] = tag.mid(valueStart, (position - valueStart));
+		}
+	}
+
+	return attributes;
+}
+
+bool HtmlBookmarksImporter::readToken(QTextStream *stream, HtmlToken *token)
+{
+	if (m_position > BUFFER_SIZE)
+	{
+		m_buffer.remove(0, m_position);
+
+		m_position = 0;
+	}
+
+	while (m_position >= m_buffer.length() || m_buffer.indexOf(((m_buffer.at(m_position) == QLatin1Char('<')) ? QLatin1Char('>') : QLatin1Char('<')), m_position) < 0)
+	{
+		if (stream->atEnd())
+		{
+			break;
+		}
+
+		m_buffer.append(stream->read(BUFFER_SIZE));
+	}
+
+	if (m_position >= m_buffer.length())
+	{
+		return false;
+	}
+
+	token->name.clear();
+	token->text.clear();
+	token->attributes.clear();
+	token->isEndTag = false;
+
+	if (m_buffer.at(m_position) != QLatin1Char('<'))
+	{
+		int end(m_buffer.indexOf(QLatin1Char('<'), m_position));
+
+		if (end < 0)
+		{
+			end = m_buffer.length();
+		}
+
+		token->text = m_buffer.mid(m_position, (end - m_position));
+
+		m_position = end;
+
+		return true;
+	}
+
+	int end(m_buffer.indexOf(QLatin1Char('>'), m_position));
+
+	if (end < 0)
+	{
+		end = m_buffer.length();
+	}
+
+	const QString tag(m_buffer.mid((m_position + 1), (end - m_position - 1)));
+
+	m_position = (end + 1);
+
+	if (tag.startsWith(QLatin1Char('!')) || tag.startsWith(QLatin1Char('?')))
+	{
+		return true;
+	}
+
+	int position(0);
+
+	if (tag.startsWith(QLatin1Char('/')))
+	{
+		token->isEndTag = true;
+
+		position = 1;
+	}
+
+	const int nameStart(position);
+
+	while (position < tag.length() && !tag.at(position).isSpace() && tag.at(position) != QLatin1Char('/'))
+	{
+		++position;
+	}
+
+	token->name = tag.mid(nameStart, (position - nameStart)).toLower();
+
+	if (!token->isEndTag)
+	{
+		token->attributes = parseAttributes(tag, position);
+	}
+
+	return true;
+}
+
 bool HtmlBookmarksImporter::import(const QString &path)
 {
-#ifdef MEERKAT_ENABLE_QTWEBKIT
 	QFile file(getSuggestedPath(path));
 
 	if (!file.open(QIODevice::ReadOnly))
@@ -219,17 +415,124 @@ bool HtmlBookmarksImporter::import(const QString &path)
 		}
 	}
 
-	QWebPage page;
-	page.mainFrame()->setHtml(file.readAll());
+	QTextStream stream(&file);
+	stream.setCodec(QTextCodec::codecForHtml(file.peek(BUFFER_SIZE), QTextCodec::codecForName("UTF-8")));
+
+	BookmarksModel *model(BookmarksManager::getModel());
+	BookmarksItem *pendingFolder(nullptr);
+	HtmlToken token;
+	QHash<QString, QString> attributes;
+	QString element;
+	QString text;
+	QVector<bool> folders;
+	const int total(int(qMax(qint64(1), file.size())));
+	int amount(0);
+
+	m_buffer.clear();
+	m_position = 0;
+	m_currentBookmark = nullptr;
+
+	model->beginChanges();
+
+	while (readToken(&stream, &token))
+	{
+		if (token.name.isEmpty())
+		{
+			if (!element.isEmpty())
+			{
+				text.append(token.text);
+			}
+
+			continue;
+		}
+
+		if (element == QLatin1String("dd"))
+		{
+			if (m_currentBookmark)
+			{
+				m_currentBookmark->setData(decodeEntities(text).trimmed(), BookmarksModel::DescriptionRole);
+			}
+
+			element.clear();
+		}
+
+		if (!token.isEndTag)
+		{
+			if (token.name == QLatin1String("a") || token.name == QLatin1String("h3"))
+			{
+				element = token.name;
+				attributes = token.attributes;
+				pendingFolder = nullptr;
+
+				text.clear();
+			}
+			else if (token.name == QLatin1String("dd"))
+			{
+				element = token.name;
+
+				text.clear();
+			}
+			else if (token.name == QLatin1String("dl"))
+			{
+				folders.append(pendingFolder != nullptr);
+
+				if (pendingFolder)
+				{
+					setCurrentFolder(pendingFolder);
+				}
+
+				pendingFolder = nullptr;
+			}
+			else if (token.name == QLatin1String("hr"))
+			{
+				BookmarksManager::addBookmark(BookmarksModel::SeparatorBookmark, QUrl(), QString(), getCurrentFolder());
+
+				pendingFolder = nullptr;
+				m_currentBookmark = nullptr;
+			}
+		}
+		else if (token.name == element)
+		{
+			const BookmarksModel::BookmarkType type((element == QLatin1String("h3")) ? BookmarksModel::FolderBookmark : BookmarksModel::UrlBookmark);
+
+			addBookmark(type, attributes, text);
+
+			if (type == BookmarksModel::FolderBookmark)
+			{
+				pendingFolder = m_currentBookmark;
+			}
+
+			element.clear();
+
+			++amount;
+
+			if (amount % PROGRESS_INTERVAL == 0)
+			{
+				emit importProgress(int(qMin(file.pos(), qint64(total))), total, BookmarksImport);
+			}
+		}
+		else if (token.name == QLatin1String("dl") && !folders.isEmpty())
+		{
+			if (folders.takeLast())
+			{
+				goToParent();
+			}
+
+			pendingFolder = nullptr;
+		}
+	}
+
+	model->endChanges();
 
-	processElement(page.mainFrame()->documentElement());
+	m_buffer.clear();
+	m_position = 0;
+	m_currentBookmark = nullptr;
 
 	file.close();
 
+	emit importProgress(total, total, BookmarksImport);
+
 	return true;
-#else
-	return false;
-#endif
 }
 
 }
@@ -25,9 +25,7 @@
 #include "../../../ui/BookmarksImporterWidget.h"
 
 #include <QtCore/QFile>
-#ifdef MEERKAT_ENABLE_QTWEBKIT
-#include <QtWebKit/QWebElement>
-#endif
+#include <QtCore/QTextStream>
 
 namespace Meerkat
 {
@@ -53,13 +51,25 @@ public:
 public slots:
 	bool import(const QString &path);
 
-#ifdef MEERKAT_ENABLE_QTWEBKIT
 protected:
-	void processElement(const QWebElement &element);
-#endif
+	struct HtmlToken
+	{
+		QString name;
+		QString text;
+		QHash<QString, QString> attributes;
+		bool isEndTag = false;
+	};
+
+	void addBookmark(BookmarksModel::BookmarkType type, const QHash<QString, QString> &attributes, const QString &title);
+	static QString decodeEntities(const QString &text);
+	static QHash<QString, QString> parseAttributes(const QString &tag, int position);
+	bool readToken(QTextStream *stream, HtmlToken *token);
 
 private:
 	BookmarksImporterWidget *m_optionsWidget;
+	BookmarksItem *m_currentBookmark;
+	QString m_buffer;
+	int m_position;
 };
 
 }
@@ -153,13 +153,23 @@ bool OperaBookmarksImporter::import(const QString &path)
 		}
 	}
 
-	BookmarksItem *bookmark(nullptr);
+	BookmarksModel *model(BookmarksManager::getModel());
 	OperaBookmarkEntry type(NoEntry);
+	QUrl url;
+	QString title;
+	QString description;
+	QString keyword;
+	QDateTime timeAdded;
+	QDateTime timeVisited;
 	bool isHeader(true);
+	bool isAtEnd(false);
 
-	while (!stream.atEnd())
+	model->beginChanges();
+
+	while (!isAtEnd)
 	{
-		line = stream.readLine();
+		isAtEnd = stream.atEnd();
+		line = (isAtEnd ? QString() : stream.readLine());
 
 		if (isHeader && (line.isEmpty() || line.at(0) != QLatin1Char('#')))
 		{
@@ -170,82 +180,93 @@ bool OperaBookmarksImporter::import(const QString &path)
 
 		if (line.startsWith(QLatin1String("#URL")))
 		{
-			bookmark = BookmarksManager::addBookmark(BookmarksModel::UrlBookmark, QUrl(), QString(), getCurrentFolder());
 			type = UrlEntry;
 		}
 		else if (line.startsWith(QLatin1String("#FOLDER")))
 		{
-			bookmark = BookmarksManager::addBookmark(BookmarksModel::FolderBookmark, QUrl(), QString(), getCurrentFolder());
 			type = FolderStartEntry;
 		}
 		else if (line.startsWith(QLatin1String("#SEPERATOR")))
 		{
-			bookmark = BookmarksManager::addBookmark(BookmarksModel::SeparatorBookmark, QUrl(), QString(), getCurrentFolder());
 			type = SeparatorEntry;
 		}
 		else if (line == QLatin1String("-"))
 		{
 			type = FolderEndEntry;
 		}
-		else if (line.startsWith(QLatin1String("\tURL=")) && bookmark)
+		else if (line.startsWith(QLatin1String("\tURL=")))
 		{
-			const QUrl url(line.section(QLatin1Char('='), 1, -1));
-
-			if (!allowDuplicates() && BookmarksManager::hasBookmark(url))
-			{
-				bookmark->remove();
-				bookmark = nullptr;
-			}
-			else
-			{
-				bookmark->setData(url, BookmarksModel::UrlRole);
-			}
+			url = QUrl(line.section(QLatin1Char('='), 1, -1));
 		}
-		else if (line.startsWith(QLatin1String("\tNAME=")) && bookmark)
+		else if (line.startsWith(QLatin1String("\tNAME=")))
 		{
-			bookmark->setData(line.section(QLatin1Char('='), 1, -1), BookmarksModel::TitleRole);
+			title = line.section(QLatin1Char('='), 1, -1);
 		}
-		else if (line.startsWith(QLatin1String("\tDESCRIPTION=")) && bookmark)
+		else if (line.startsWith(QLatin1String("\tDESCRIPTION=")))
 		{
-			bookmark->setData(line.section(QLatin1Char('='), 1, -1).replace(QLatin1String("\x02\x02"), QLatin1String("\n")), BookmarksModel::DescriptionRole);
+			description = line.section(QLatin1Char('='), 1, -1).replace(QLatin1String("\x02\x02"), QLatin1String("\n"));
 		}
-		else if (line.startsWith(QLatin1String("\tSHORT NAME=")) && bookmark)
+		else if (line.startsWith(QLatin1String("\tSHORT NAME=")))
 		{
-			const QString keyword(line.section(QLatin1Char('='), 1, -1));
-
-			if (!BookmarksManager::hasKeyword(keyword))
-			{
-				bookmark->setData(keyword, BookmarksModel::KeywordRole);
-			}
+			keyword = line.section(QLatin1Char('='), 1, -1);
 		}
-		else if (line.startsWith(QLatin1String("\tCREATED=")) && bookmark)
+		else if (line.startsWith(QLatin1String("\tCREATED=")))
 		{
-			bookmark->setData(QDateTime::fromTime_t(line.section(QLatin1Char('='), 1, -1).toUInt()), BookmarksModel::TimeAddedRole);
+			timeAdded = QDateTime::fromTime_t(line.section(QLatin1Char('='), 1, -1).toUInt());
 		}
-		else if (line.startsWith(QLatin1String("\tVISITED=")) && bookmark)
+		else if (line.startsWith(QLatin1String("\tVISITED=")))
 		{
-			bookmark->setData(QDateTime::fromTime_t(line.section(QLatin1Char('='), 1, -1).toUInt()), BookmarksModel::TimeVisitedRole);
+			timeVisited = QDateTime::fromTime_t(line.section(QLatin1Char('='), 1, -1).toUInt());
 		}
 		else if (line.isEmpty())
 		{
-			if (bookmark)
+			if (type == FolderEndEntry)
+			{
+				goToParent();
+			}
+			else if (type != NoEntry && (type != UrlEntry || allowDuplicates() || !BookmarksManager::hasBookmark(url)))
 			{
+				const BookmarksModel::BookmarkType bookmarkType((type == FolderStartEntry) ? BookmarksModel::FolderBookmark : ((type == SeparatorEntry) ? BookmarksModel::SeparatorBookmark : BookmarksModel::UrlBookmark));
+				BookmarksItem *bookmark(BookmarksManager::addBookmark(bookmarkType, ((type == UrlEntry) ? url : QUrl()), title, getCurrentFolder()));
+
+				if (!description.isEmpty())
+				{
+					bookmark->setData(description, BookmarksModel::DescriptionRole);
+				}
+
+				if (!keyword.isEmpty() && !BookmarksManager::hasKeyword(keyword))
+				{
+					bookmark->setData(keyword, BookmarksModel::KeywordRole);
+				}
+
+				if (timeAdded.isValid())
+				{
+					bookmark->setData(timeAdded, BookmarksModel::TimeAddedRole);
+				}
+
+				if (timeVisited.isValid())
+				{
+					bookmark->setData(timeVisited, BookmarksModel::TimeVisitedRole);
+				}
+
 				if (type == FolderStartEntry)
 				{
 					setCurrentFolder(bookmark);
 				}
-
-				bookmark = nullptr;
-			}
-			else if (type == FolderEndEntry)
-			{
-				goToParent();
 			}
 
 			type = NoEntry;
+			url.clear();
+			title.clear();
+			description.clear();
+			keyword.clear();
+			timeAdded = QDateTime();
+			timeVisited = QDateTime();
 		}
 	}
 
+	model->endChanges();
+
 	file.close();
 
 	return true;
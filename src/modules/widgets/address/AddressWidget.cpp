@@ -29,8 +29,10 @@
 #include "../../../ui/Window.h"
 #include "../../../core/AddressCompletionModel.h"
 #include "../../../core/BookmarksManager.h"
+#include "../../../core/ContentBlockingManager.h"
 #include "../../../core/InputInterpreter.h"
 #include "../../../core/HistoryManager.h"
+#include "../../../core/PreconnectManager.h"
 #include "../../../core/SearchEnginesManager.h"
 #include "../../../core/ThemesManager.h"
 #include "../../../core/Utils.h"
@@ -986,6 +988,24 @@ void AddressWidget::setCompletion(const QString &filter)
 		return;
 	}
 
+	if ((!m_window || !m_window->isPrivate()) && PreconnectManager::isEnabled())
+	{
+		for (int i = 0; i < m_completionModel->rowCount(); ++i)
+		{
+			const QModelIndex index(m_completionModel->index(i));
+			const AddressCompletionModel::EntryType type(static_cast<AddressCompletionModel::EntryType>(index.data(AddressCompletionModel::TypeRole).toInt()));
+
+			if (type != AddressCompletionModel::HeaderType && type != AddressCompletionModel::SearchSuggestionType)
+			{
+				const QUrl url(index.data(AddressCompletionModel::UrlRole).toUrl());
+
+				PreconnectManager::preconnect(url, url, ContentBlockingManager::getProfileList(SettingsManager::getValue(SettingsManager::ContentBlocking_ProfilesOption, url).toStringList()));
+
+				break;
+			}
+		}
+	}
+
 	if (m_completionModes.testFlag(PopupCompletionMode))
 	{
 		if (!m_completionView)
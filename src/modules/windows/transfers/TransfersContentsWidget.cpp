@@ -32,6 +32,7 @@
 #include <QtGui/QClipboard>
 #include <QtGui/QKeyEvent>
 #include <QtWidgets/QApplication>
+#include <QtWidgets/QInputDialog>
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QMessageBox>
 
@@ -78,7 +79,7 @@ TransfersContentsWidget::TransfersContentsWidget(Window *window) : ContentsWidge
 	m_ui->redownloadButton->setIcon(ThemesManager::getIcon(QLatin1String("view-refresh")));
 	m_ui->downloadLineEdit->installEventFilter(this);
 
-	const QList<Transfer*> transfers(TransfersManager::getTransfers());
+	const QList<Transfer*> transfers(TransfersManager::getTransfers(true));
 
 	for (int i = 0; i < transfers.count(); ++i)
 	{
@@ -361,6 +362,26 @@ void TransfersContentsWidget::redownloadTransfer()
 	}
 }
 
+void TransfersContentsWidget::verifyTransfer()
+{
+	Transfer *transfer(getTransfer(m_ui->transfersViewWidget->selectionModel()->hasSelection() ? m_ui->transfersViewWidget->selectionModel()->currentIndex() : QModelIndex()));
+
+	if (!transfer)
+	{
+		return;
+	}
+
+	bool isConfirmed(false);
+	const QString hash(QInputDialog::getText(this, tr("Verify Checksum"), tr("Enter expected SHA-256 or MD5 checksum:"), QLineEdit::Normal, QString::fromLatin1(transfer->getExpectedHash()), &isConfirmed));
+
+	if (isConfirmed && !transfer->setExpectedHash(hash.toLatin1()))
+	{
+		QMessageBox::warning(this, tr("Error"), tr("Invalid checksum."));
+	}
+
+	updateActions();
+}
+
 void TransfersContentsWidget::startQuickTransfer()
 {
 	TransfersManager::startTransfer(m_ui->downloadLineEdit->text(), QString(), (Transfer::CanNotifyOption | Transfer::IsQuickTransferOption | (SessionsManager::isPrivate() ? Transfer::IsPrivateOption : Transfer::NoOption)));
@@ -407,6 +428,7 @@ void TransfersContentsWidget::showContextMenu(const QPoint &point)
 		menu.addAction(tr("Redownload"), this, SLOT(redownloadTransfer()));
 		menu.addSeparator();
 		menu.addAction(tr("Copy Transfer Information"), this, SLOT(copyTransferInformation()));
+		menu.addAction(tr("Verify Checksum…"), this, SLOT(verifyTransfer()));
 		menu.addSeparator();
 		menu.addAction(tr("Remove"), this, SLOT(removeTransfer()));
 	}
@@ -456,6 +478,42 @@ void TransfersContentsWidget::updateActions()
 		m_ui->sizeLabelWidget->setText(Utils::formatUnit(transfer->getBytesTotal(), false, 1, true));
 		m_ui->downloadedLabelWidget->setText(Utils::formatUnit(transfer->getBytesReceived(), false, 1, true));
 		m_ui->progressLabelWidget->setText(QStringLiteral("%1%").arg(((transfer->getBytesTotal() > 0) ? ((static_cast<qreal>(transfer->getBytesReceived()) / transfer->getBytesTotal()) * 100) : 0.0), 0, 'f', 1));
+
+		const bool isMd5(transfer->getExpectedHash().length() == 32);
+		const QString hash(QString::fromLatin1(transfer->getHash(isMd5 ? QCryptographicHash::Md5 : QCryptographicHash::Sha256)));
+		const QString checksum(hash.isEmpty() ? QString() : QStringLiteral("%1: %2").arg(isMd5 ? QLatin1String("MD5") : QLatin1String("SHA-256")).arg(hash));
+
+		switch (transfer->getHashState())
+		{
+			case Transfer::ComputingHashState:
+				m_ui->checksumLabelWidget->setText(tr("Computing…"));
+
+				break;
+			case Transfer::ValidHashState:
+				m_ui->checksumLabelWidget->setText(tr("%1 (matches expected checksum)").arg(checksum));
+
+				break;
+			case Transfer::InvalidHashState:
+				m_ui->checksumLabelWidget->setText(tr("%1 (does not match expected checksum %2)").arg(checksum).arg(QString::fromLatin1(transfer->getExpectedHash())));
+
+				break;
+			default:
+				m_ui->checksumLabelWidget->setText(checksum);
+
+				break;
+		}
+
+		const QString duplicate((transfer->getState() == Transfer::FinishedState) ? TransfersManager::findDuplicate(transfer->getHash(QCryptographicHash::Sha256), transfer->getBytesTotal(), transfer->getTarget()) : QString());
+
+		if (duplicate.isEmpty())
+		{
+			m_ui->duplicateLabelWidget->clear();
+		}
+		else
+		{
+			m_ui->duplicateLabelWidget->setText(duplicate);
+			m_ui->duplicateLabelWidget->setUrl(QUrl(duplicate));
+		}
 	}
 	else
 	{
@@ -464,6 +522,8 @@ void TransfersContentsWidget::updateActions()
 		m_ui->sizeLabelWidget->clear();
 		m_ui->downloadedLabelWidget->clear();
 		m_ui->progressLabelWidget->clear();
+		m_ui->checksumLabelWidget->clear();
+		m_ui->duplicateLabelWidget->clear();
 	}
 }
 
@@ -80,6 +80,7 @@ protected slots:
 	void copyTransferInformation();
 	void stopResumeTransfer();
 	void redownloadTransfer();
+	void verifyTransfer();
 	void startQuickTransfer();
 	void clearFinishedTransfers();
 	void showContextMenu(const QPoint &point);
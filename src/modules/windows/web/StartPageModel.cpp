@@ -22,9 +22,9 @@
 #include "../../../core/BookmarksManager.h"
 #include "../../../core/SessionsManager.h"
 #include "../../../core/SettingsManager.h"
+#include "../../../core/ThumbnailsManager.h"
 #include "../../../core/WebBackend.h"
 
-#include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QMimeData>
 #include <QtGui/QPainter>
@@ -38,7 +38,11 @@ StartPageModel::StartPageModel(QObject *parent) : QStandardItemModel(parent),
 	optionChanged(SettingsManager::Backends_WebOption);
 	reloadModel();
 
-	connect(BookmarksManager::getModel(), SIGNAL(modelModified()), this, SLOT(reloadModel()));
+	connect(BookmarksManager::getModel(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(handleBookmarksInserted(QModelIndex,int,int)));
+	connect(BookmarksManager::getModel(), SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)), this, SLOT(handleBookmarksAboutToBeRemoved(QModelIndex,int,int)));
+	connect(BookmarksManager::getModel(), SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(handleBookmarksDataChanged(QModelIndex,QModelIndex)));
+	connect(BookmarksManager::getModel(), SIGNAL(modelAboutToBeReset()), this, SLOT(handleBookmarksAboutToBeReset()));
+	connect(BookmarksManager::getModel(), SIGNAL(modelReset()), this, SLOT(reloadModel()));
 	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int)));
 }
 
@@ -46,7 +50,7 @@ void StartPageModel::optionChanged(int identifier)
 {
 	if (identifier == SettingsManager::Backends_WebOption)
 	{
-		connect(AddonsManager::getWebBackend(), SIGNAL(thumbnailAvailable(QUrl,QPixmap,QString)), this, SLOT(thumbnailCreated(QUrl,QPixmap,QString)));
+		connect(AddonsManager::getWebBackend(), SIGNAL(thumbnailAvailable(QUrl,QImage,QString)), this, SLOT(thumbnailCreated(QUrl,QImage,QString)));
 	}
 	else if (identifier == SettingsManager::StartPage_BookmarksFolderOption || identifier == SettingsManager::StartPage_ShowAddTileOption)
 	{
@@ -67,7 +71,7 @@ void StartPageModel::dragEnded()
 	}
 }
 
-void StartPageModel::thumbnailCreated(const QUrl &url, const QPixmap &thumbnail, const QString &title)
+void StartPageModel::thumbnailCreated(const QUrl &url, const QImage &thumbnail, const QString &title)
 {
 	if (!m_reloads.contains(url))
 	{
@@ -76,11 +80,7 @@ void StartPageModel::thumbnailCreated(const QUrl &url, const QPixmap &thumbnail,
 
 	if (!thumbnail.isNull())
 	{
-		const QString path(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")));
-
-		QDir().mkpath(path);
-
-		thumbnail.save(path + QString::number(m_reloads[url].first) + QLatin1String(".png"), "png");
+		ThumbnailsManager::storeThumbnail(url, thumbnail, getTileSize());
 	}
 
 	BookmarksItem *bookmark(BookmarksManager::getModel()->getBookmark(m_reloads[url].first));
@@ -98,27 +98,168 @@ void StartPageModel::thumbnailCreated(const QUrl &url, const QPixmap &thumbnail,
 	m_reloads.remove(url);
 }
 
+void StartPageModel::handleBookmarksInserted(const QModelIndex &parent, int first, int last)
+{
+	if (!m_bookmark || parent != m_bookmark->index())
+	{
+		return;
+	}
+
+	int row(0);
+
+	for (int i = 0; i < first; ++i)
+	{
+		if (isTile(m_bookmark->child(i)))
+		{
+			++row;
+		}
+	}
+
+	const bool needsThumbnails(SettingsManager::getValue(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail"));
+	bool wasModified(false);
+
+	for (int i = first; i <= last; ++i)
+	{
+		QStandardItem *item(createTile(m_bookmark->child(i), needsThumbnails));
+
+		if (item)
+		{
+			insertRow(row, item);
+
+			++row;
+
+			wasModified = true;
+		}
+	}
+
+	if (wasModified)
+	{
+		emit modelModified();
+	}
+}
+
+void StartPageModel::handleBookmarksAboutToBeReset()
+{
+	m_bookmark = nullptr;
+}
+
+void StartPageModel::handleBookmarksAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+	if (!m_bookmark)
+	{
+		return;
+	}
+
+	const QModelIndex folderIndex(m_bookmark->index());
+
+	if (parent != folderIndex)
+	{
+		QModelIndex index(folderIndex);
+
+		while (index.isValid())
+		{
+			if (index.parent() == parent && index.row() >= first && index.row() <= last)
+			{
+				m_bookmark = nullptr;
+
+				QMetaObject::invokeMethod(this, "reloadModel", Qt::QueuedConnection);
+
+				return;
+			}
+
+			index = index.parent();
+		}
+
+		return;
+	}
+
+	bool wasModified(false);
+
+	for (int i = first; i <= last; ++i)
+	{
+		const int row(getTileRow(m_bookmark->child(i)));
+
+		if (row >= 0)
+		{
+			removeRow(row);
+
+			wasModified = true;
+		}
+	}
+
+	if (wasModified)
+	{
+		emit modelModified();
+	}
+}
+
+void StartPageModel::handleBookmarksDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+	if (!m_bookmark || topLeft.parent() != m_bookmark->index())
+	{
+		return;
+	}
+
+	const bool needsThumbnails(SettingsManager::getValue(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail"));
+	bool wasModified(false);
+
+	for (int i = topLeft.row(); i <= bottomRight.row(); ++i)
+	{
+		QStandardItem *bookmark(m_bookmark->child(i));
+		const int row(getTileRow(bookmark));
+
+		if (row < 0)
+		{
+			if (isTile(bookmark))
+			{
+				handleBookmarksInserted(topLeft.parent(), i, i);
+			}
+
+			continue;
+		}
+
+		QStandardItem *item(createTile(bookmark, needsThumbnails));
+
+		if (item)
+		{
+			setItem(row, item);
+		}
+		else
+		{
+			removeRow(row);
+		}
+
+		wasModified = true;
+	}
+
+	if (wasModified)
+	{
+		emit modelModified();
+	}
+}
+
 void StartPageModel::reloadModel()
 {
 	const QString path(SettingsManager::getValue(SettingsManager::StartPage_BookmarksFolderOption).toString());
+	BookmarksItem *bookmark(BookmarksManager::getModel()->getItem(path));
 
-	m_bookmark = BookmarksManager::getModel()->getItem(path);
+	m_bookmark = nullptr;
 
-	if (!m_bookmark)
+	if (!bookmark)
 	{
 		const QStringList directories(path.split(QLatin1Char('/'), QString::SkipEmptyParts));
 
-		m_bookmark = BookmarksManager::getModel()->getRootItem();
+		bookmark = BookmarksManager::getModel()->getRootItem();
 
 		for (int i = 0; i < directories.count(); ++i)
 		{
 			bool hasFound(false);
 
-			for (int j = 0; j < m_bookmark->rowCount(); ++j)
+			for (int j = 0; j < bookmark->rowCount(); ++j)
 			{
-				if (m_bookmark->child(j) && m_bookmark->child(j)->data(Qt::DisplayRole) == directories.at(i))
+				if (bookmark->child(j) && bookmark->child(j)->data(Qt::DisplayRole) == directories.at(i))
 				{
-					m_bookmark = dynamic_cast<BookmarksItem*>(m_bookmark->child(j));
+					bookmark = dynamic_cast<BookmarksItem*>(bookmark->child(j));
 
 					hasFound = true;
 
@@ -128,42 +269,25 @@ void StartPageModel::reloadModel()
 
 			if (!hasFound)
 			{
-				disconnect(BookmarksManager::getModel(), SIGNAL(modelModified()), this, SLOT(reloadModel()));
-
-				m_bookmark = BookmarksManager::getModel()->addBookmark(BookmarksModel::FolderBookmark, 0, QUrl(), directories.at(i), m_bookmark);
-
-				connect(BookmarksManager::getModel(), SIGNAL(modelModified()), this, SLOT(reloadModel()));
+				bookmark = BookmarksManager::getModel()->addBookmark(BookmarksModel::FolderBookmark, 0, QUrl(), directories.at(i), bookmark);
 			}
 		}
 	}
 
+	m_bookmark = bookmark;
+
 	clear();
 
 	if (m_bookmark)
 	{
+		const bool needsThumbnails(SettingsManager::getValue(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail"));
+
 		for (int i = 0; i < m_bookmark->rowCount(); ++i)
 		{
-			if (m_bookmark->child(i))
-			{
-				const BookmarksModel::BookmarkType type(static_cast<BookmarksModel::BookmarkType>(m_bookmark->child(i)->data(BookmarksModel::TypeRole).toInt()));
-
-				if (type != BookmarksModel::UrlBookmark && type != BookmarksModel::FolderBookmark)
-				{
-					continue;
-				}
-
-				const quint64 identifier(m_bookmark->child(i)->data(BookmarksModel::IdentifierRole).toULongLong());
-				const QUrl url(m_bookmark->child(i)->data(BookmarksModel::UrlRole).toUrl());
-				QStandardItem *item(m_bookmark->child(i)->clone());
-				item->setData(identifier, BookmarksModel::IdentifierRole);
-
-				if (url.isValid() && SettingsManager::getValue(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail") && !QFile::exists(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(identifier) + QLatin1String(".png")))
-				{
-					m_reloads[url] = qMakePair(identifier, false);
-
-					AddonsManager::getWebBackend()->requestThumbnail(url, QSize(SettingsManager::getValue(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getValue(SettingsManager::StartPage_TileHeightOption).toInt()));
-				}
+			QStandardItem *item(createTile(m_bookmark->child(i), needsThumbnails));
 
+			if (item)
+			{
 				appendRow(item);
 			}
 		}
@@ -194,8 +318,7 @@ void StartPageModel::reloadTile(const QModelIndex &index, bool full)
 
 		if (SettingsManager::getValue(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail"))
 		{
-			size.setWidth(SettingsManager::getValue(SettingsManager::StartPage_TileWidthOption).toInt());
-			size.setHeight(SettingsManager::getValue(SettingsManager::StartPage_TileHeightOption).toInt());
+			size = getTileSize();
 		}
 		else if (!full)
 		{
@@ -206,8 +329,8 @@ void StartPageModel::reloadTile(const QModelIndex &index, bool full)
 		{
 			const AddonsManager::SpecialPageInformation information(AddonsManager::getSpecialPage(url.path()));
 
-			QPixmap thumbnail(size);
-			thumbnail.fill();
+			QImage thumbnail(size, QImage::Format_ARGB32);
+			thumbnail.fill(Qt::white);
 
 			QPainter painter(&thumbnail);
 
@@ -224,6 +347,37 @@ void StartPageModel::reloadTile(const QModelIndex &index, bool full)
 	}
 }
 
+QStandardItem* StartPageModel::createTile(QStandardItem *bookmark, bool needsThumbnail)
+{
+	if (!isTile(bookmark))
+	{
+		return nullptr;
+	}
+
+	const quint64 identifier(bookmark->data(BookmarksModel::IdentifierRole).toULongLong());
+	const QUrl url(bookmark->data(BookmarksModel::UrlRole).toUrl());
+	QStandardItem *item(bookmark->clone());
+	item->setData(identifier, BookmarksModel::IdentifierRole);
+
+	if (needsThumbnail && url.isValid() && !m_reloads.contains(url) && !ThumbnailsManager::hasThumbnail(url, getTileSize()))
+	{
+		const QString legacyPath(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(identifier) + QLatin1String(".png"));
+
+		if (QFile::exists(legacyPath) && !SessionsManager::isPrivate() && !SessionsManager::isReadOnly())
+		{
+			ThumbnailsManager::importThumbnail(url, legacyPath, getTileSize());
+		}
+		else
+		{
+			m_reloads[url] = qMakePair(identifier, false);
+
+			AddonsManager::getWebBackend()->requestThumbnail(url, getTileSize());
+		}
+	}
+
+	return item;
+}
+
 QMimeData* StartPageModel::mimeData(const QModelIndexList &indexes) const
 {
 	QMimeData *mimeData(new QMimeData());
@@ -254,6 +408,31 @@ QMimeData* StartPageModel::mimeData(const QModelIndexList &indexes) const
 	return mimeData;
 }
 
+QSize StartPageModel::getTileSize()
+{
+	return QSize(SettingsManager::getValue(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getValue(SettingsManager::StartPage_TileHeightOption).toInt());
+}
+
+int StartPageModel::getTileRow(QStandardItem *bookmark) const
+{
+	if (!bookmark)
+	{
+		return -1;
+	}
+
+	const quint64 identifier(bookmark->data(BookmarksModel::IdentifierRole).toULongLong());
+
+	for (int i = 0; i < rowCount(); ++i)
+	{
+		if (item(i) && item(i)->data(BookmarksModel::IdentifierRole).toULongLong() == identifier)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 QVariant StartPageModel::data(const QModelIndex &index, int role) const
 {
 	if (role == IsReloadingRole)
@@ -269,6 +448,18 @@ QStringList StartPageModel::mimeTypes() const
 	return QStringList(QLatin1String("text/uri-list"));
 }
 
+bool StartPageModel::isTile(QStandardItem *bookmark)
+{
+	if (!bookmark)
+	{
+		return false;
+	}
+
+	const BookmarksModel::BookmarkType type(static_cast<BookmarksModel::BookmarkType>(bookmark->data(BookmarksModel::TypeRole).toInt()));
+
+	return (type == BookmarksModel::UrlBookmark || type == BookmarksModel::FolderBookmark);
+}
+
 bool StartPageModel::dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent)
 {
 	Q_UNUSED(action)
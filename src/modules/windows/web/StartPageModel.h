@@ -41,11 +41,17 @@ public:
 	explicit StartPageModel(QObject *parent = nullptr);
 
 	QMimeData* mimeData(const QModelIndexList &indexes) const;
+	static QSize getTileSize();
 	QVariant data(const QModelIndex &index, int role) const;
 	QStringList mimeTypes() const;
 	bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent);
 	bool event(QEvent *event);
 
+protected:
+	QStandardItem* createTile(QStandardItem *bookmark, bool needsThumbnail);
+	int getTileRow(QStandardItem *bookmark) const;
+	static bool isTile(QStandardItem *bookmark);
+
 public slots:
 	void reloadModel();
 	void reloadTile(const QModelIndex &index, bool full = false);
@@ -53,7 +59,11 @@ public slots:
 protected slots:
 	void optionChanged(int identifier);
 	void dragEnded();
-	void thumbnailCreated(const QUrl &url, const QPixmap &thumbnail, const QString &title);
+	void thumbnailCreated(const QUrl &url, const QImage &thumbnail, const QString &title);
+	void handleBookmarksInserted(const QModelIndex &parent, int first, int last);
+	void handleBookmarksAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+	void handleBookmarksAboutToBeReset();
+	void handleBookmarksDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
 
 private:
 	BookmarksItem *m_bookmark;
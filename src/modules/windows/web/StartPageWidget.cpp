@@ -23,10 +23,13 @@
 #include "StartPagePreferencesDialog.h"
 #include "TileDelegate.h"
 #include "WebContentsWidget.h"
+#include "../../../core/AddonsManager.h"
 #include "../../../core/BookmarksModel.h"
 #include "../../../core/GesturesManager.h"
 #include "../../../core/SettingsManager.h"
+#include "../../../core/ThumbnailsManager.h"
 #include "../../../core/Utils.h"
+#include "../../../core/WebBackend.h"
 #include "../../../core/WindowsManager.h"
 #include "../../../modules/widgets/search/SearchWidget.h"
 #include "../../../ui/BookmarkPropertiesDialog.h"
@@ -39,6 +42,7 @@
 #include <QtGui/QPainter>
 #include <QtGui/QPixmapCache>
 #include <QtCore/QtMath>
+#include <QtCore/QTimer>
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QScrollBar>
 
@@ -195,6 +199,8 @@ StartPageWidget::StartPageWidget(Window *window, QWidget *parent) : QScrollArea(
 
 	connect(m_model, SIGNAL(modelModified()), this, SLOT(updateTiles()));
 	connect(m_model, SIGNAL(isReloadingTileChanged(QModelIndex)), this, SLOT(updateTile(QModelIndex)));
+	connect(ThumbnailsManager::getInstance(), SIGNAL(thumbnailAvailable(QUrl,QSize)), m_listView->viewport(), SLOT(update()));
+	connect(verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(updateThumbnailsPriority()));
 	connect(SettingsManager::getInstance(), SIGNAL(valueChanged(int,QVariant)), this, SLOT(optionChanged(int,QVariant)));
 }
 
@@ -502,12 +508,7 @@ void StartPageWidget::removeTile()
 
 	if (bookmark)
 	{
-		const QString path(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(bookmark->data(BookmarksModel::IdentifierRole).toULongLong()) + QLatin1String(".png"));
-
-		if (QFile::exists(path))
-		{
-			QFile::remove(path);
-		}
+		ThumbnailsManager::removeThumbnail(bookmark->data(BookmarksModel::UrlRole).toUrl(), StartPageModel::getTileSize());
 
 		bookmark->remove();
 	}
@@ -543,6 +544,35 @@ void StartPageWidget::updateTiles()
 	}
 
 	updateSize();
+
+	QTimer::singleShot(0, this, SLOT(updateThumbnailsPriority()));
+}
+
+void StartPageWidget::updateThumbnailsPriority()
+{
+	WebBackend *backend(AddonsManager::getWebBackend());
+
+	if (!backend || SettingsManager::getValue(SettingsManager::StartPage_TileBackgroundModeOption) != QLatin1String("thumbnail"))
+	{
+		return;
+	}
+
+	const QRect visibleRectangle(viewport()->rect());
+
+	for (int i = (m_model->rowCount() - 1); i >= 0; --i)
+	{
+		const QModelIndex index(m_model->index(i, 0));
+
+		if (index.data(StartPageModel::IsReloadingRole).toBool())
+		{
+			const QRect rectangle(m_listView->visualRect(index));
+
+			if (QRect(m_listView->viewport()->mapTo(viewport(), rectangle.topLeft()), rectangle.size()).intersects(visibleRectangle))
+			{
+				backend->requestThumbnail(index.data(BookmarksModel::UrlRole).toUrl(), StartPageModel::getTileSize(), true);
+			}
+		}
+	}
 }
 
 void StartPageWidget::showContextMenu(const QPoint &position)
@@ -88,6 +88,7 @@ protected slots:
 	void updateTile(const QModelIndex &index);
 	void updateSize();
 	void updateTiles();
+	void updateThumbnailsPriority();
 
 private:
 	Window *m_window;
@@ -20,9 +20,9 @@
 #include "TileDelegate.h"
 #include "StartPageModel.h"
 #include "../../../core/HistoryManager.h"
-#include "../../../core/SessionsManager.h"
 #include "../../../core/SettingsManager.h"
 #include "../../../core/ThemesManager.h"
+#include "../../../core/ThumbnailsManager.h"
 
 #include <QtGui/QGuiApplication>
 #include <QtGui/QMovie>
@@ -99,7 +99,7 @@ void TileDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
 		painter->setBrush(Qt::white);
 		painter->setPen(Qt::transparent);
 		painter->drawRect(rectangle);
-		painter->drawPixmap(rectangle, QPixmap(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(index.data(BookmarksModel::IdentifierRole).toULongLong()) + QLatin1String(".png")));
+		painter->drawPixmap(rectangle, ThumbnailsManager::getThumbnail(index.data(BookmarksModel::UrlRole).toUrl(), StartPageModel::getTileSize()));
 	}
 	else if (tileBackgroundMode == QLatin1String("favicon"))
 	{
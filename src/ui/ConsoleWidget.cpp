@@ -35,6 +35,7 @@ namespace Meerkat
 ConsoleWidget::ConsoleWidget(QWidget *parent) : QWidget(parent),
 	m_model(nullptr),
 	m_messageScopes(AllTabsScope | OtherSourcesScope),
+	m_lastMessage(0),
 	m_ui(new Ui::ConsoleWidget)
 {
 	m_ui->setupUi(this);
@@ -93,28 +94,50 @@ void ConsoleWidget::showEvent(QShowEvent *event)
 		m_model = new QStandardItemModel(this);
 		m_model->setSortRole(TimeRole);
 
-		const QList<Console::Message> messages(Console::getMessages());
-
-		for (int i = 0; i < messages.count(); ++i)
-		{
-			addMessage(messages.at(i));
-		}
-
 		m_ui->consoleView->setModel(m_model);
 
-		connect(Console::getInstance(), SIGNAL(messageAdded(Console::Message)), this, SLOT(addMessage(Console::Message)));
+		addMessages();
+
+		connect(Console::getInstance(), SIGNAL(messagesAdded()), this, SLOT(addMessages()));
 	}
 
 	QWidget::showEvent(event);
 }
 
-void ConsoleWidget::addMessage(const Console::Message &message)
+void ConsoleWidget::addMessages()
 {
 	if (!m_model)
 	{
 		return;
 	}
 
+	const QList<Console::Message> messages(Console::getMessages(m_lastMessage));
+
+	if (messages.isEmpty())
+	{
+		return;
+	}
+
+	m_lastMessage = messages.last().identifier;
+
+	const QList<Console::MessageCategory> categories(getCategories());
+	const quint64 currentWindow(getCurrentWindow());
+	const QString filter(m_ui->filterLineEdit->text());
+
+	m_ui->consoleView->setUpdatesEnabled(false);
+
+	for (int i = 0; i < messages.count(); ++i)
+	{
+		addMessage(messages.at(i));
+
+		applyFilters(m_model->item(0, 0), filter, categories, currentWindow);
+	}
+
+	m_ui->consoleView->setUpdatesEnabled(true);
+}
+
+void ConsoleWidget::addMessage(const Console::Message &message)
+{
 	QIcon icon;
 	QString category;
 
@@ -154,8 +177,10 @@ void ConsoleWidget::addMessage(const Console::Message &message)
 			break;
 	}
 
+	const QDateTime time(message.getTime());
 	const QString source(message.source + ((message.line > 0) ? QStringLiteral(":%1").arg(message.line) : QString()));
-	QString entry(QStringLiteral("[%1] %2").arg(message.time.toString()).arg(category));
+	const QString note(message.getNote());
+	QString entry(QStringLiteral("[%1] %2").arg(time.toString()).arg(category));
 
 	if (!message.source.isEmpty())
 	{
@@ -163,20 +188,17 @@ void ConsoleWidget::addMessage(const Console::Message &message)
 	}
 
 	QStandardItem *item(new QStandardItem(icon, entry));
-	item->setData(message.time.toTime_t(), TimeRole);
+	item->setData(time.toTime_t(), TimeRole);
 	item->setData(message.category, CategoryRole);
 	item->setData(source, SourceRole);
 	item->setData(message.window, WindowRole);
 
-	if (!message.note.isEmpty())
+	if (!note.isEmpty())
 	{
-		item->appendRow(new QStandardItem(message.note));
+		item->appendRow(new QStandardItem(note));
 	}
 
-	m_model->appendRow(item);
-	m_model->sort(0, Qt::DescendingOrder);
-
-	applyFilters(item, m_ui->filterLineEdit->text(), getCategories(), getCurrentWindow());
+	m_model->insertRow(0, item);
 }
 
 void ConsoleWidget::clear()
@@ -61,12 +61,13 @@ protected:
 	Q_DECLARE_FLAGS(MessagesScopes, MessagesScope)
 
 	void showEvent(QShowEvent *event);
+	void addMessage(const Console::Message &message);
 	void applyFilters(QStandardItem *item, const QString &filter, const QList<Console::MessageCategory> &categories, quint64 currentWindow);
 	QList<Console::MessageCategory> getCategories() const;
 	quint64 getCurrentWindow();
 
 protected slots:
-	void addMessage(const Console::Message &message);
+	void addMessages();
 	void clear();
 	void copyText();
 	void filterCategories();
@@ -76,6 +77,7 @@ protected slots:
 private:
 	QStandardItemModel *m_model;
 	MessagesScopes m_messageScopes;
+	quint64 m_lastMessage;
 	Ui::ConsoleWidget *m_ui;
 };
 
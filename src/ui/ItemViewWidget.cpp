@@ -201,7 +201,9 @@ ItemViewWidget::ItemViewWidget(QWidget *parent) : QTreeView(parent),
 	m_sortColumn(-1),
 	m_dragRow(-1),
 	m_dropRow(-1),
+	m_filterTimer(0),
 	m_canGatherExpanded(false),
+	m_isFilterNarrowable(false),
 	m_isModified(false),
 	m_isInitialized(false)
 {
@@ -224,6 +226,16 @@ ItemViewWidget::ItemViewWidget(QWidget *parent) : QTreeView(parent),
 	connect(m_headerWidget, SIGNAL(sectionMoved(int,int,int)), this, SLOT(saveState()));
 }
 
+void ItemViewWidget::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_filterTimer)
+	{
+		updateFilter();
+	}
+
+	QTreeView::timerEvent(event);
+}
+
 void ItemViewWidget::showEvent(QShowEvent *event)
 {
 	if (m_isInitialized)
@@ -577,12 +589,94 @@ void ItemViewWidget::updateDropSelection()
 
 void ItemViewWidget::updateFilter()
 {
+	if (m_filterTimer != 0)
+	{
+		killTimer(m_filterTimer);
+
+		m_filterTimer = 0;
+	}
+
+	if (!model())
+	{
+		return;
+	}
+
+	const QString filter(m_filterString.toLower());
+
+	if (filter.isEmpty() && m_appliedFilterString.isEmpty())
+	{
+		return;
+	}
+
+	if (m_appliedFilterString.isEmpty())
+	{
+		connect(model(), SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(invalidateFilter(QModelIndex,QModelIndex)));
+		connect(model(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(scheduleFilterUpdate()));
+		connect(model(), SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(scheduleFilterUpdate()));
+		connect(model(), SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(invalidateFilter()));
+		connect(model(), SIGNAL(modelReset()), this, SLOT(invalidateFilter()));
+	}
+
+	const bool isNarrowing(m_isFilterNarrowable && !m_appliedFilterString.isEmpty() && filter.contains(m_appliedFilterString));
+	QSet<QStandardItem*> matchedItems;
+
+	m_canGatherExpanded = m_appliedFilterString.isEmpty();
+
+	setUpdatesEnabled(false);
+
 	for (int i = 0; i < getRowCount(); ++i)
 	{
-		applyFilter(getIndex(i, 0));
+		applyFilter(getIndex(i, 0), filter, isNarrowing, matchedItems);
+	}
+
+	setUpdatesEnabled(true);
+
+	m_matchedItems = matchedItems;
+	m_appliedFilterString = filter;
+	m_isFilterNarrowable = true;
+
+	if (filter.isEmpty())
+	{
+		m_expandedBranches.clear();
+		m_filterKeys.clear();
+		m_matchedItems.clear();
+
+		disconnect(model(), SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(invalidateFilter(QModelIndex,QModelIndex)));
+		disconnect(model(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(scheduleFilterUpdate()));
+		disconnect(model(), SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(scheduleFilterUpdate()));
+		disconnect(model(), SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(invalidateFilter()));
+		disconnect(model(), SIGNAL(modelReset()), this, SLOT(invalidateFilter()));
+	}
+}
+
+void ItemViewWidget::scheduleFilterUpdate()
+{
+	m_isFilterNarrowable = false;
+
+	if (m_filterTimer == 0)
+	{
+		m_filterTimer = startTimer(150);
 	}
 }
 
+void ItemViewWidget::invalidateFilter()
+{
+	m_filterKeys.clear();
+	m_matchedItems.clear();
+
+	scheduleFilterUpdate();
+}
+
+void ItemViewWidget::invalidateFilter(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+	for (int i = topLeft.row(); i <= bottomRight.row(); ++i)
+	{
+		m_filterKeys.remove(getFilterItem(topLeft.sibling(i, 0)));
+	}
+
+	scheduleFilterUpdate();
+}
+
 void ItemViewWidget::setSort(int column, Qt::SortOrder order)
 {
 	if (column == m_sortColumn && order == m_sortOrder)
@@ -624,31 +718,21 @@ void ItemViewWidget::setFilterString(const QString filter)
 		return;
 	}
 
-	if (m_filterString.isEmpty())
-	{
-		connect(model(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(updateFilter()));
-		connect(model(), SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(updateFilter()));
-		connect(model(), SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(updateFilter()));
-	}
-
-	m_canGatherExpanded = m_filterString.isEmpty();
 	m_filterString = filter;
 
-	updateFilter();
-
-	if (m_filterString.isEmpty())
+	if (m_filterTimer != 0)
 	{
-		m_expandedBranches.clear();
-
-		disconnect(model(), SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(updateFilter()));
-		disconnect(model(), SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(updateFilter()));
-		disconnect(model(), SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(updateFilter()));
+		killTimer(m_filterTimer);
 	}
+
+	m_filterTimer = startTimer(150);
 }
 
 void ItemViewWidget::setFilterRoles(const QSet<int> &roles)
 {
 	m_filterRoles = roles;
+	m_filterKeys.clear();
+	m_isFilterNarrowable = false;
 }
 
 void ItemViewWidget::setData(const QModelIndex &index, const QVariant &value, int role)
@@ -683,6 +767,9 @@ void ItemViewWidget::setModel(QAbstractItemModel *model, bool useSortProxy)
 	}
 
 	m_sourceModel = qobject_cast<QStandardItemModel*>(model);
+	m_filterKeys.clear();
+	m_matchedItems.clear();
+	m_isFilterNarrowable = false;
 
 	QTreeView::setModel(usedModel);
 
@@ -732,6 +819,60 @@ QStandardItem* ItemViewWidget::getItem(int row, int column, const QModelIndex &p
 	return(m_sourceModel ? m_sourceModel->itemFromIndex(getIndex(row, column, parent)) : nullptr);
 }
 
+QStandardItem* ItemViewWidget::getFilterItem(const QModelIndex &index) const
+{
+	if (!m_sourceModel)
+	{
+		return nullptr;
+	}
+
+	return m_sourceModel->itemFromIndex(m_proxyModel ? m_proxyModel->mapToSource(index) : index);
+}
+
+QString ItemViewWidget::getFilterKey(const QModelIndex &index)
+{
+	QStandardItem *item(getFilterItem(index));
+
+	if (item && m_filterKeys.contains(item))
+	{
+		return m_filterKeys[item];
+	}
+
+	QStringList values;
+	const int columnCount(getColumnCount(index.parent()));
+
+	for (int i = 0; i < columnCount; ++i)
+	{
+		const QModelIndex childIndex(index.sibling(index.row(), i));
+
+		if (!childIndex.isValid())
+		{
+			continue;
+		}
+
+		QSet<int>::iterator iterator;
+
+		for (iterator = m_filterRoles.begin(); iterator != m_filterRoles.end(); ++iterator)
+		{
+			const QString value(childIndex.data(*iterator).toString());
+
+			if (!value.isEmpty())
+			{
+				values.append(value);
+			}
+		}
+	}
+
+	const QString key(values.join(QLatin1Char('\n')).toLower());
+
+	if (item)
+	{
+		m_filterKeys[item] = key;
+	}
+
+	return key;
+}
+
 QModelIndex ItemViewWidget::getIndex(int row, int column, const QModelIndex &parent) const
 {
 	return (model() ? model()->index(row, column, parent) : QModelIndex());
@@ -792,65 +933,58 @@ bool ItemViewWidget::canMoveDown() const
 	return (currentRow >= 0 && rowCount > 1 && currentRow < (rowCount - 1));
 }
 
-bool ItemViewWidget::applyFilter(const QModelIndex &index)
+bool ItemViewWidget::applyFilter(const QModelIndex &index, const QString &filter, bool isNarrowing, QSet<QStandardItem*> &matchedItems)
 {
-	bool hasFound(m_filterString.isEmpty());
+	QStandardItem *item(getFilterItem(index));
 	const bool isFolder(!index.flags().testFlag(Qt::ItemNeverHasChildren));
+	bool hasFound(filter.isEmpty());
 
-	if (isFolder)
+	if (isFolder && m_canGatherExpanded && isExpanded(index))
 	{
-		if (m_canGatherExpanded && isExpanded(index))
-		{
-			m_expandedBranches.insert(index);
-		}
+		m_expandedBranches.insert(index);
+	}
 
+	if (isNarrowing && item && !m_matchedItems.contains(item))
+	{
+		hasFound = false;
+	}
+	else if (isFolder)
+	{
 		const int rowCount(getRowCount(index));
 
 		for (int i = 0; i < rowCount; ++i)
 		{
-			if (applyFilter(index.child(i, 0)))
+			if (applyFilter(index.child(i, 0), filter, isNarrowing, matchedItems))
 			{
 				hasFound = true;
 			}
 		}
 	}
-	else
+	else if (!hasFound)
 	{
-		const int columnCount(index.parent().isValid() ? getRowCount(index.parent()) : getColumnCount());
-
-		for (int i = 0; i < columnCount; ++i)
-		{
-			const QModelIndex childIndex(index.sibling(index.row(), i));
-
-			if (!childIndex.isValid())
-			{
-				continue;
-			}
-
-			QSet<int>::iterator iterator;
+		hasFound = getFilterKey(index).contains(filter);
+	}
 
-			for (iterator = m_filterRoles.begin(); iterator != m_filterRoles.end(); ++iterator)
-			{
-				if (childIndex.data(*iterator).toString().contains(m_filterString, Qt::CaseInsensitive))
-				{
-					hasFound = true;
+	if (hasFound && item && !filter.isEmpty())
+	{
+		matchedItems.insert(item);
+	}
 
-					break;
-				}
-			}
+	const bool isHidden(!hasFound || (isFolder && getRowCount(index) == 0));
 
-			if (hasFound)
-			{
-				break;
-			}
-		}
+	if (isRowHidden(index.row(), index.parent()) != isHidden)
+	{
+		setRowHidden(index.row(), index.parent(), isHidden);
 	}
 
-	setRowHidden(index.row(), index.parent(), (!hasFound || (isFolder && getRowCount(index) == 0)));
-
 	if (isFolder)
 	{
-		setExpanded(index, ((hasFound && !m_filterString.isEmpty()) || (m_filterString.isEmpty() && m_expandedBranches.contains(index))));
+		const bool shouldExpand((hasFound && !filter.isEmpty()) || (filter.isEmpty() && m_expandedBranches.contains(index)));
+
+		if (isExpanded(index) != shouldExpand)
+		{
+			setExpanded(index, shouldExpand);
+		}
 	}
 
 	return hasFound;
@@ -100,12 +100,15 @@ public slots:
 	void setFilterRoles(const QSet<int> &roles);
 
 protected:
+	void timerEvent(QTimerEvent *event);
 	void showEvent(QShowEvent *event);
 	void keyPressEvent(QKeyEvent *event);
 	void dropEvent(QDropEvent *event);
 	void startDrag(Qt::DropActions supportedActions);
 	void moveRow(bool up);
-	bool applyFilter(const QModelIndex &index);
+	QStandardItem* getFilterItem(const QModelIndex &index) const;
+	QString getFilterKey(const QModelIndex &index);
+	bool applyFilter(const QModelIndex &index, const QString &filter, bool isNarrowing, QSet<QStandardItem*> &matchedItems);
 
 protected slots:
 	void optionChanged(int identifier, const QVariant &value);
@@ -114,12 +117,18 @@ protected slots:
 	void notifySelectionChanged();
 	void updateDropSelection();
 	void updateFilter();
+	void scheduleFilterUpdate();
+	void invalidateFilter();
+	void invalidateFilter(const QModelIndex &topLeft, const QModelIndex &bottomRight);
 
 private:
 	HeaderViewWidget *m_headerWidget;
 	QStandardItemModel *m_sourceModel;
 	QSortFilterProxyModel *m_proxyModel;
 	QString m_filterString;
+	QString m_appliedFilterString;
+	QHash<QStandardItem*, QString> m_filterKeys;
+	QSet<QStandardItem*> m_matchedItems;
 	QSet<QModelIndex> m_expandedBranches;
 	QSet<int> m_filterRoles;
 	ViewMode m_viewMode;
@@ -127,7 +136,9 @@ private:
 	int m_sortColumn;
 	int m_dragRow;
 	int m_dropRow;
+	int m_filterTimer;
 	bool m_canGatherExpanded;
+	bool m_isFilterNarrowable;
 	bool m_isModified;
 	bool m_isInitialized;
 
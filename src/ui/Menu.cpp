@@ -530,28 +530,21 @@ void Menu::populateSessionsMenu()
 	m_actionGroup->setExclusive(true);
 
 	const QStringList sessions(SessionsManager::getSessions());
-	QMultiHash<QString, SessionInformation> information;
+	QMultiHash<QString, SessionSummary> information;
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
-		const SessionInformation session(SessionsManager::getSession(sessions.at(i)));
+		const SessionSummary session(SessionsManager::getSessionSummary(sessions.at(i)));
 
 		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
 	}
 
-	const QList<SessionInformation> sorted(information.values());
+	const QList<SessionSummary> sorted(information.values());
 	const QString currentSession(SessionsManager::getCurrentSession());
 
 	for (int i = 0; i < sorted.count(); ++i)
 	{
-		int windows(0);
-
-		for (int j = 0; j < sorted.at(i).windows.count(); ++j)
-		{
-			windows += sorted.at(i).windows.at(j).windows.count();
-		}
-
-		QAction *action(QMenu::addAction(tr("%1 (%n tab(s))", "", windows).arg(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : QString(sorted.at(i).title).replace(QLatin1Char('&'), QLatin1String("&&")))));
+		QAction *action(QMenu::addAction(tr("%1 (%n tab(s))", "", sorted.at(i).tabs).arg(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : QString(sorted.at(i).title).replace(QLatin1Char('&'), QLatin1String("&&")))));
 		action->setData(sorted.at(i).path);
 		action->setCheckable(true);
 		action->setChecked(sorted.at(i).path == currentSession);
@@ -33,7 +33,7 @@ SaveSessionDialog::SaveSessionDialog(QWidget *parent) : Dialog(parent),
 	m_ui(new Ui::SaveSessionDialog)
 {
 	m_ui->setupUi(this);
-	m_ui->titleLineEdit->setText(SessionsManager::getSession(SessionsManager::getCurrentSession()).title);
+	m_ui->titleLineEdit->setText(SessionsManager::getSessionSummary(SessionsManager::getCurrentSession()).title);
 	m_ui->identifierLineEdit->setText(SessionsManager::getCurrentSession());
 	m_ui->identifierLineEdit->setValidator(new QRegularExpressionValidator(QRegularExpression(QLatin1String("[a-z0-9\\-_]+")), this));
 
@@ -65,7 +65,7 @@ void SaveSessionDialog::saveSession()
 		return;
 	}
 
-	if (m_ui->identifierLineEdit->text() != SessionsManager::getCurrentSession() && SessionsManager::getSession(m_ui->identifierLineEdit->text()).windows.count() > 0 && QMessageBox::question(this, tr("Question"), tr("Session with specified indentifier already exists.\nDo you want to overwrite it?"), QMessageBox::Yes, QMessageBox::No) == QMessageBox::No)
+	if (m_ui->identifierLineEdit->text() != SessionsManager::getCurrentSession() && SessionsManager::getSessionSummary(m_ui->identifierLineEdit->text()).windows > 0 && QMessageBox::question(this, tr("Question"), tr("Session with specified indentifier already exists.\nDo you want to overwrite it?"), QMessageBox::Yes, QMessageBox::No) == QMessageBox::No)
 	{
 		show();
 
@@ -20,6 +20,7 @@
 #include "SourceViewerWidget.h"
 #include "../core/SettingsManager.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -33,7 +34,10 @@ namespace Meerkat
 
 QMap<SyntaxHighlighter::HighlightingSyntax, QMap<SyntaxHighlighter::HighlightingState, QTextCharFormat> > SyntaxHighlighter::m_formats;
 
-SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent) : QSyntaxHighlighter(parent)
+SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent) : QSyntaxHighlighter(parent),
+	m_highlightingLimit(-1),
+	m_highlightingChunk(100),
+	m_highlightingTimer(0)
 {
 	if (m_formats[HtmlSyntax].isEmpty())
 	{
@@ -93,102 +97,165 @@ SyntaxHighlighter::SyntaxHighlighter(QTextDocument *parent) : QSyntaxHighlighter
 	}
 }
 
+void SyntaxHighlighter::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_highlightingTimer)
+	{
+		QSyntaxHighlighter::timerEvent(event);
+
+		return;
+	}
+
+	killTimer(m_highlightingTimer);
+
+	m_highlightingTimer = 0;
+
+	QTextBlock block(document()->findBlockByNumber(m_highlightingLimit + 1));
+
+	if (!block.isValid())
+	{
+		return;
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+
+	m_highlightingLimit += m_highlightingChunk;
+
+	rehighlightBlock(block);
+
+	const qint64 elapsed(qMax(qint64(1), timer.elapsed()));
+
+	m_highlightingChunk = qBound(1, static_cast<int>((m_highlightingChunk * 10) / elapsed), 10000);
+
+	if (m_highlightingTimer == 0 && document()->findBlockByNumber(m_highlightingLimit + 1).isValid())
+	{
+		m_highlightingTimer = startTimer(0);
+	}
+}
+
 void SyntaxHighlighter::highlightBlock(const QString &text)
 {
-	QString buffer;
-	BlockData currentData;
+	if (currentBlock().blockNumber() > m_highlightingLimit)
+	{
+// marks block as pending, so that it will be highlighted later in idle time
+		setCurrentBlockState(-2);
+
+		if (m_highlightingTimer == 0)
+		{
+			m_highlightingTimer = startTimer(0);
+		}
+
+		return;
+	}
+
+	const QMap<HighlightingState, QTextCharFormat> &formats(m_formats[HtmlSyntax]);
+	const QChar *characters(text.constData());
+	const int length(text.length());
 	HighlightingState previousState(static_cast<HighlightingState>(qMax(previousBlockState(), 0)));
 	HighlightingState currentState(previousState);
+	HighlightingState valueState(NoState);
+	QChar quote;
 	int previousStateBegin(0);
 	int currentStateBegin(0);
 	int position(0);
 
 	if (currentBlock().previous().userData())
 	{
-		currentData = *static_cast<BlockData*>(currentBlock().previous().userData());
+		const BlockData *previousData(static_cast<BlockData*>(currentBlock().previous().userData()));
+
+		if (!previousData->context.isEmpty())
+		{
+			quote = previousData->context.at(0);
+			valueState = previousData->state;
+		}
 	}
 
-	while (position < text.length())
+	while (position < length)
 	{
-		buffer.append(text.at(position));
+		const QChar character(characters[position]);
+		const bool isWordCharacter(character == QLatin1Char('-') || character.isLetterOrNumber());
 
 		++position;
 
-		const bool isEndOfLine(position == text.length());
+		const bool isEndOfLine(position == length);
 
-		if (currentState == NoState && text.at(position - 1) == QLatin1Char('<'))
+		if (currentState == NoState && character == QLatin1Char('<'))
 		{
 			currentState = KeywordState;
 			currentStateBegin = (position - 1);
 		}
-		else if ((currentState == KeywordState || currentState == DoctypeState) && text.at(position - 1) == QLatin1Char('>'))
+		else if ((currentState == KeywordState || currentState == DoctypeState) && character == QLatin1Char('>'))
 		{
 			currentState = NoState;
 			currentStateBegin = position;
 		}
-		else if (currentState == AttributeState && text.length() > position && text.at(position) == QLatin1Char('>'))
+		else if (currentState == AttributeState && position < length && characters[position] == QLatin1Char('>'))
 		{
 			currentState = KeywordState;
 			currentStateBegin = position;
 		}
-		else if (currentState == KeywordState && buffer == QLatin1String("!DOCTYPE"))
+		else if (currentState == KeywordState && (position - currentStateBegin) == 9 && text.midRef((currentStateBegin + 1), 8) == QLatin1String("!DOCTYPE"))
 		{
 			currentState = DoctypeState;
 		}
-		else if (currentState == KeywordState && buffer == QLatin1String("!--"))
+		else if (currentState == KeywordState && (position - currentStateBegin) == 4 && text.midRef((currentStateBegin + 1), 3) == QLatin1String("!--"))
 		{
 			currentState = CommentState;
 		}
-		else if (currentState == CommentState && buffer.endsWith(QLatin1String("-->")))
+		else if (currentState == CommentState && character == QLatin1Char('>') && position >= 3 && (position - 3) > currentStateBegin && text.midRef((position - 3), 3) == QLatin1String("-->"))
 		{
 			currentState = NoState;
 			currentStateBegin = position;
 		}
-		else if (currentState == KeywordState && (text.at(position - 1) == QLatin1Char('-') || text.at(position - 1).isLetter() || text.at(position - 1).isNumber()) && (position == 1 || (position > 1 && text.at(position - 2).isSpace())))
+		else if (currentState == KeywordState && isWordCharacter && (position == 1 || characters[position - 2].isSpace()))
 		{
 			currentState = AttributeState;
 			currentStateBegin = (position - 1);
 		}
-		else if (currentState == AttributeState && !(text.at(position - 1) == QLatin1Char('-') || text.at(position - 1).isLetter() || text.at(position - 1).isNumber()))
+		else if (currentState == AttributeState && !isWordCharacter)
 		{
 			currentState = KeywordState;
 			currentStateBegin = (position - 1);
 		}
-		else if ((currentState == KeywordState || currentState == DoctypeState || currentState == AttributeState) && (text.at(position - 1) == QLatin1Char('\'') || text.at(position - 1) == QLatin1Char('"')))
+		else if ((currentState == KeywordState || currentState == DoctypeState || currentState == AttributeState) && (character == QLatin1Char('\'') || character == QLatin1Char('"')))
 		{
-			currentData.context = text.at(position - 1);
-			currentData.state = currentState;
+			quote = character;
+			valueState = currentState;
 			currentState = ValueState;
 			currentStateBegin = (position - 1);
 		}
-		else if (currentState == ValueState && text.at(position - 1) == currentData.context)
+		else if (currentState == ValueState && character == quote)
 		{
-			currentState = currentData.state;
+			currentState = valueState;
 			currentStateBegin = position;
-			currentData.context = QString();
-			currentData.state = NoState;
+			quote = QChar();
+			valueState = NoState;
 		}
 
 		if (previousState != currentState || isEndOfLine)
 		{
-			setFormat(previousStateBegin, (position - previousStateBegin), m_formats[HtmlSyntax][previousState]);
+			setFormat(previousStateBegin, (position - previousStateBegin), formats[previousState]);
 
 			if (isEndOfLine)
 			{
-				setFormat(currentStateBegin, (position - currentStateBegin), m_formats[HtmlSyntax][currentState]);
+				setFormat(currentStateBegin, (position - currentStateBegin), formats[currentState]);
 			}
 
-			buffer = QString();
 			previousState = currentState;
 			previousStateBegin = currentStateBegin;
 		}
 	}
 
-	if (!currentData.context.isEmpty())
+	if (quote.isNull())
+	{
+		setCurrentBlockUserData(nullptr);
+	}
+	else
 	{
 		BlockData *nextBlockData(new BlockData());
-		nextBlockData->context = currentData.context;
-		nextBlockData->state = currentData.state;
+		nextBlockData->context = quote;
+		nextBlockData->state = valueState;
 
 		setCurrentBlockUserData(nextBlockData);
 	}
@@ -196,6 +263,11 @@ void SyntaxHighlighter::highlightBlock(const QString &text)
 	setCurrentBlockState(currentState);
 }
 
+void SyntaxHighlighter::setHighlightingLimit(int limit)
+{
+	m_highlightingLimit = limit;
+}
+
 MarginWidget::MarginWidget(SourceViewerWidget *parent) : QWidget(parent),
 	m_sourceViewer(parent),
 	m_lastClickedLine(-1)
@@ -324,11 +396,12 @@ bool MarginWidget::event(QEvent *event)
 }
 
 SourceViewerWidget::SourceViewerWidget(QWidget *parent) : QPlainTextEdit(parent),
+	m_highlighter(nullptr),
 	m_marginWidget(nullptr),
 	m_findFlags(WebWidget::NoFlagsFind),
 	m_zoom(100)
 {
-	new SyntaxHighlighter(document());
+	m_highlighter = new SyntaxHighlighter(document());
 
 	setZoom(SettingsManager::getValue(SettingsManager::Content_DefaultZoomOption).toInt());
 	optionChanged(SettingsManager::Interface_ShowScrollBarsOption, SettingsManager::getValue(SettingsManager::Interface_ShowScrollBarsOption));
@@ -452,6 +525,13 @@ void SourceViewerWidget::updateSelection()
 	setExtraSelections(extraSelections);
 }
 
+void SourceViewerWidget::setPlainText(const QString &text)
+{
+	m_highlighter->setHighlightingLimit(viewport()->height() / qMax(1, fontMetrics().height()));
+
+	QPlainTextEdit::setPlainText(text);
+}
+
 void SourceViewerWidget::setZoom(int zoom)
 {
 	if (zoom != m_zoom)
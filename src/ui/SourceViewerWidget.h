@@ -62,10 +62,17 @@ public:
 
 	explicit SyntaxHighlighter(QTextDocument *parent);
 
+	void setHighlightingLimit(int limit);
+
 protected:
+	void timerEvent(QTimerEvent *event);
 	void highlightBlock(const QString &text);
 
 private:
+	int m_highlightingLimit;
+	int m_highlightingChunk;
+	int m_highlightingTimer;
+
 	static QMap<HighlightingSyntax, QMap<HighlightingState, QTextCharFormat> > m_formats;
 };
 
@@ -101,6 +108,7 @@ class SourceViewerWidget : public QPlainTextEdit
 public:
 	explicit SourceViewerWidget(QWidget *parent = nullptr);
 
+	void setPlainText(const QString &text);
 	void setZoom(int zoom);
 	int getZoom() const;
 	bool findText(const QString &text, WebWidget::FindFlags flags = WebWidget::NoFlagsFind);
@@ -116,6 +124,7 @@ protected slots:
 	void updateSelection();
 
 private:
+	SyntaxHighlighter *m_highlighter;
 	MarginWidget *m_marginWidget;
 	QString m_findText;
 	QTextCursor m_findTextAnchor;
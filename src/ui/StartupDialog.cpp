@@ -34,16 +34,16 @@ StartupDialog::StartupDialog(const QString &session, QWidget *parent) : Dialog(p
 	m_ui->windowsTreeView->setModel(m_windowsModel);
 
 	const QStringList sessions(SessionsManager::getSessions());
-	QMultiHash<QString, SessionInformation> information;
+	QMultiHash<QString, SessionSummary> information;
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
-		const SessionInformation session(SessionsManager::getSession(sessions.at(i)));
+		const SessionSummary session(SessionsManager::getSessionSummary(sessions.at(i)));
 
 		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
 	}
 
-	const QList<SessionInformation> sorted(information.values());
+	const QList<SessionSummary> sorted(information.values());
 
 	for (int i = 0; i < sorted.count(); ++i)
 	{
@@ -28,6 +28,7 @@
 #include "../core/GesturesManager.h"
 #include "../core/SettingsManager.h"
 #include "../core/ThemesManager.h"
+#include "../core/ThumbnailsManager.h"
 
 #include <QtCore/QMimeData>
 #include <QtCore/QtMath>
@@ -138,6 +139,7 @@ TabHandleWidget::TabHandleWidget(Window *window, TabBarWidget *parent) : QWidget
 	connect(window, SIGNAL(titleChanged(QString)), this, SLOT(update()));
 	connect(window, SIGNAL(iconChanged(QIcon)), this, SLOT(update()));
 	connect(window, SIGNAL(loadingStateChanged(WindowsManager::LoadingState)), this, SLOT(handleLoadingStateChanged(WindowsManager::LoadingState)));
+	connect(ThumbnailsManager::getInstance(), SIGNAL(thumbnailAvailable(QUrl,QSize)), this, SLOT(handleThumbnailAvailable(QUrl)));
 	connect(parent, SIGNAL(currentChanged(int)), this, SLOT(updateGeometries()));
 	connect(parent, SIGNAL(tabsAmountChanged(int)), this, SLOT(updateGeometries()));
 	connect(parent, SIGNAL(needsGeometriesUpdate()), this, SLOT(updateGeometries()));
@@ -370,6 +372,14 @@ void TabHandleWidget::handleLoadingStateChanged(WindowsManager::LoadingState sta
 	}
 }
 
+void TabHandleWidget::handleThumbnailAvailable(const QUrl &url)
+{
+	if (m_thumbnailRectangle.isValid() && m_window && m_window->getUrl() == url)
+	{
+		update();
+	}
+}
+
 void TabHandleWidget::updateGeometries()
 {
 	if (!m_window)
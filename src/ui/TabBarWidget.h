@@ -79,6 +79,7 @@ protected slots:
 	void markAsActive();
 	void markAsNeedingAttention();
 	void handleLoadingStateChanged(WindowsManager::LoadingState state);
+	void handleThumbnailAvailable(const QUrl &url);
 	void updateGeometries();
 
 private:
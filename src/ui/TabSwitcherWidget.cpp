@@ -20,6 +20,7 @@
 #include "TabSwitcherWidget.h"
 #include "Window.h"
 #include "../core/ThemesManager.h"
+#include "../core/ThumbnailsManager.h"
 #include "../core/WindowsManager.h"
 
 #include <QtGui/QKeyEvent>
@@ -68,6 +69,7 @@ TabSwitcherWidget::TabSwitcherWidget(WindowsManager *manager, QWidget *parent) :
 	m_previewLabel->setStyleSheet(QLatin1String("border:1px solid gray;"));
 
 	connect(m_tabsView->selectionModel(), SIGNAL(currentChanged(QModelIndex,QModelIndex)), this, SLOT(currentTabChanged(QModelIndex)));
+	connect(ThumbnailsManager::getInstance(), SIGNAL(thumbnailAvailable(QUrl,QSize)), this, SLOT(handleThumbnailAvailable(QUrl)));
 }
 
 void TabSwitcherWidget::showEvent(QShowEvent *event)
@@ -192,6 +194,22 @@ void TabSwitcherWidget::tabRemoved(qint64 identifier)
 	}
 }
 
+void TabSwitcherWidget::handleThumbnailAvailable(const QUrl &url)
+{
+	if (!isVisible())
+	{
+		return;
+	}
+
+	const QModelIndex index(m_tabsView->currentIndex());
+	Window *window(m_windowsManager->getWindowByIdentifier(index.data(Qt::UserRole).toLongLong()));
+
+	if (window && window->getUrl() == url)
+	{
+		currentTabChanged(index);
+	}
+}
+
 void TabSwitcherWidget::show(SwitcherReason reason)
 {
 	m_reason = reason;
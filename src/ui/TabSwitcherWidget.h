@@ -63,6 +63,7 @@ protected slots:
 	void currentTabChanged(const QModelIndex &index);
 	void tabAdded(qint64 identifier);
 	void tabRemoved(qint64 identifier);
+	void handleThumbnailAvailable(const QUrl &url);
 	void setTitle(const QString &title);
 	void setIcon(const QIcon &icon);
 